@@ -0,0 +1,40 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    atomic.h
+ * @brief   This file contains the function prototypes of the lock-free atomic
+ *          operations.
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l4xx_hal.h"
+
+/* Functions -----------------------------------------------------------------*/
+uint32_t AtomicFetchOr(volatile uint32_t* const address, const uint32_t mask);
+uint32_t AtomicFetchAnd(volatile uint32_t* const address, const uint32_t mask);
+uint32_t AtomicFetchAdd(volatile uint32_t* const address, const uint32_t value);
+uint32_t AtomicExchange(volatile uint32_t* const address, const uint32_t value);
+uint8_t AtomicExchangeByte(volatile uint8_t* const address,
+                           const uint8_t value);
+uint8_t AtomicCompareExchange(volatile uint32_t* const address,
+                              const uint32_t expected,
+                              const uint32_t desired);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATOMIC_H */
@@ -22,9 +22,19 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include "stm32l4xx_hal.h"
 
+/* Defines -------------------------------------------------------------------*/
+/** Minimum time in [ms] spent in STOP2 mode for which entering into STOP2 mode
+ * is worth its cost, i.e. the time to re-configure the clocks and the
+ * peripherals upon entry and exit compared to staying in sleep mode */
+#define STOP2_BREAK_EVEN_TIME 20U
+
 /* Functions -----------------------------------------------------------------*/
 void EnterStop2Mode(void);
+void EnterSleepMode(void);
 void ResumeFromStop2Mode(void);
+uint8_t IsCoreStopped(void);
+uint8_t IsStop2ModeWorthwhile(const uint32_t seconds,
+                               const uint16_t milliseconds);
 
 #ifdef __cplusplus
 }
@@ -24,11 +24,13 @@ extern "C" {
 /* Functions -----------------------------------------------------------------*/
 void RtcInit(void);
 uint32_t RtcGetEpoch(void);
+uint32_t RtcGetEpochWithFraction(uint16_t* const milliseconds);
 void RtcConvertEpochToDatetime(uint32_t epoch,
                                RTC_DateTypeDef* date,
                                RTC_TimeTypeDef* time);
 uint8_t RtcSetAlarmFromEpoch(const uint32_t epoch);
 void RtcDeactivateAlarm(void);
+void RtcTriggerAlarmInterrupt(void);
 void RtcWaitForClockSynchronization(void);
 
 #ifdef __cplusplus
@@ -23,47 +23,700 @@ extern "C" {
 #include "stm32l4xx_hal.h"
 
 /* Defines -------------------------------------------------------------------*/
-/** Maximum number of jobs that are allowed to be configured */
-#define MAX_NUM_OF_JOBS 10U
+/** Queue backend: binary min-heap ordered by deadline */
+#define SCHEDULER_QUEUE_HEAP 0U
+/** Queue backend: hierarchical timing wheel with second, minute, hour and day
+ * levels */
+#define SCHEDULER_QUEUE_WHEEL 1U
+/** Queue backend: packed 16-bit remaining times, updated two jobs at a time by
+ * the SIMD instructions of the Cortex-M4 core */
+#define SCHEDULER_QUEUE_PACKED 2U
+
+/** Queue backend of the scheduler, selected at compile time */
+#ifndef SCHEDULER_QUEUE
+#define SCHEDULER_QUEUE SCHEDULER_QUEUE_HEAP
+#endif
+
+/** Number of levels of the timing wheel */
+#define SCHEDULER_WHEEL_LEVELS 4U
+/** Maximum number of slots on a single level of the timing wheel */
+#define SCHEDULER_WHEEL_SLOTS 60U
+
+/** Number of 16-bit lanes of the packed queue, i.e. the maximum capacity of a
+ * scheduler instance with the packed queue backend. Must be a multiple of
+ * 32. */
+#ifndef SCHEDULER_PACKED_LANES
+#define SCHEDULER_PACKED_LANES 64U
+#endif
+
+/** Width in bits of the period fields of the jobs: 32 (default) or 16. With
+ * 16-bit periods, each job needs less RAM, but the periods are limited to
+ * ::SCHEDULER_MAX_PERIOD, thus daily calendar jobs are not supported. */
+#ifndef SCHEDULER_PERIOD_BITS
+#define SCHEDULER_PERIOD_BITS 32U
+#endif
+
+/** Maximum period in [s] of a job */
+#if(SCHEDULER_PERIOD_BITS == 16U)
+#define SCHEDULER_MAX_PERIOD 0xFFFFU
+#else
+#define SCHEDULER_MAX_PERIOD 0xFFFFFFFFU
+#endif
+
+/** Type of the request of a job that is cancelled at the next processing step,
+ * see the request field of ::Job_t */
+#define SCHEDULER_REQUEST_CANCEL 2U
+
+/** Index value denoting the absence of a job */
+#define SCHEDULER_NO_JOB 0xFFFFU
+
+/** Maximum capacity of a scheduler instance */
+#define SCHEDULER_MAX_CAPACITY 0xFFFEU
+
+/** Number of 32-bit words of a bitmask with one bit per job */
+#define SCHEDULER_BITMAP_WORDS(capacity) (((capacity) + 31U) / 32U)
+
+/** Define the job storage of a scheduler instance with a given capacity.
+ * The storage is passed to ::SchedulerInit() by the ::SCHEDULER_INIT()
+ * macro. */
+#define SCHEDULER_STORAGE_DEFINE(name, capacity)                               \
+    SCHEDULER_STORAGE_DEFINE_IN(name, capacity, )
+
+/** Define the job storage of a scheduler instance with a given capacity and
+ * placement, e.g. `__attribute__((section(".sram2")))` with GCC and Keil, or
+ * `@ ".sram2"` with IAR. The storage does not need to be initialized, thus it
+ * can be placed into a section that is not initialized by the startup code. */
+#define SCHEDULER_STORAGE_DEFINE_IN(name, capacity, placement)                 \
+    struct                                                                     \
+    {                                                                          \
+        Job_t jobs[(capacity)];                                                \
+        JobData_t jobData[(capacity)];                                         \
+        uint32_t bitmaps[5U * SCHEDULER_BITMAP_WORDS(capacity)];               \
+    } name placement
+
+/** Check at compile time that a capacity fits into the queue backend, i.e. into
+ * the lanes of the packed queue. An oversized capacity results in an array of
+ * negative size. */
+#if(SCHEDULER_QUEUE == SCHEDULER_QUEUE_PACKED)
+#define SCHEDULER_CHECK_CAPACITY(capacity)                                     \
+    ((void)sizeof(char[((capacity) <= SCHEDULER_PACKED_LANES) ? 1 : -1]))
+#else
+#define SCHEDULER_CHECK_CAPACITY(capacity) ((void)0U)
+#endif
+
+/** Initialize a scheduler instance with a storage defined by
+ * ::SCHEDULER_STORAGE_DEFINE() or ::SCHEDULER_STORAGE_DEFINE_IN() */
+#define SCHEDULER_INIT(sched, storage)                                         \
+    (SCHEDULER_CHECK_CAPACITY(sizeof((storage).jobs) / sizeof(Job_t)),         \
+     SchedulerInit((sched),                                                    \
+                   (storage).jobs,                                             \
+                   (storage).jobData,                                          \
+                   (storage).bitmaps,                                          \
+                   (uint16_t)(sizeof((storage).jobs) / sizeof(Job_t))))
+
+/** Size in bytes of the job storage of a scheduler instance with a given
+ * capacity. The total RAM footprint of an instance is the size of the
+ * ::Scheduler_t structure and the size of its job storage. */
+#define SCHEDULER_STORAGE_SIZE(capacity)                                       \
+    (((capacity) * (sizeof(Job_t) + sizeof(JobData_t))) +                      \
+     (5U * SCHEDULER_BITMAP_WORDS(capacity) * sizeof(uint32_t)))
+
+/** Alignment in bytes of the blocks allocated from the scratch arena, a power
+ * of two */
+#define SCHEDULER_SCRATCH_ALIGNMENT 8U
+
+/** Define the scratch arena of a scheduler instance with a given size in
+ * bytes, aligned to ::SCHEDULER_SCRATCH_ALIGNMENT. The arena is passed to
+ * ::SchedulerSetScratchArena() together with its size. */
+#define SCHEDULER_SCRATCH_DEFINE(name, size)                                   \
+    uint64_t name[((size) + SCHEDULER_SCRATCH_ALIGNMENT - 1U) /                \
+                  SCHEDULER_SCRATCH_ALIGNMENT]
+
+/** Missed-deadline policy: execute the job once, regardless of the number of
+ * missed activations */
+#define SCHEDULER_POLICY_RUN_ONCE 0U
+/** Missed-deadline policy: skip the execution if activations have been
+ * missed and resume at the next deadline */
+#define SCHEDULER_POLICY_SKIP 1U
+/** Missed-deadline policy: execute the job once for each missed activation,
+ * up to the catch-up limit of the job */
+#define SCHEDULER_POLICY_CATCH_UP 2U
+
+/** Priority class: the highest priority. The jobs of this class are never
+ * deferred by the execution budget of the scheduler. */
+#define SCHEDULER_PRIORITY_CRITICAL 0U
+/** Priority class: high priority */
+#define SCHEDULER_PRIORITY_HIGH 1U
+/** Priority class: normal priority, the default priority of the jobs */
+#define SCHEDULER_PRIORITY_NORMAL 2U
+/** Priority class: the lowest priority */
+#define SCHEDULER_PRIORITY_LOW 3U
+
+/** Backoff mode: the period is lengthened by the base period of the job */
+#define SCHEDULER_BACKOFF_LINEAR 0U
+/** Backoff mode: the period is doubled */
+#define SCHEDULER_BACKOFF_EXPONENTIAL 1U
+
+/** Analysis result flag: the utilization exceeds the budget or the capacity of
+ * the CPU */
+#define SCHEDULER_ANALYSIS_OVERLOAD 0x01U
+/** Analysis result flag: the average current exceeds the energy budget */
+#define SCHEDULER_ANALYSIS_ENERGY 0x02U
+/** Analysis result flag: the hyperperiod exceeds 32 bits or the wakeups have
+ * not been enumerated, thus the awake time is estimated with one wakeup per
+ * execution */
+#define SCHEDULER_ANALYSIS_ESTIMATED 0x04U
+
+/** Maximum number of wakeups per hyperperiod that are enumerated by the
+ * analysis, which bounds its execution time. Beyond the limit, each execution
+ * of a job is counted as a separate wakeup. */
+#ifndef SCHEDULER_ANALYSIS_MAX_WAKEUPS
+#define SCHEDULER_ANALYSIS_MAX_WAKEUPS 32768U
+#endif
+
+/** Handle value denoting an invalid job */
+#define SCHEDULER_INVALID_HANDLE 0U
+
+/** Job type: periodic job, optionally with a delayed start */
+#define SCHEDULER_JOB_PERIODIC 0U
+/** Job type: one-shot job, released after its single execution */
+#define SCHEDULER_JOB_ONE_SHOT 1U
+/** Job type: calendar job, executed at a given time of the day or hour */
+#define SCHEDULER_JOB_CALENDAR 2U
+/** Job type: triggered job, executed after each execution of its predecessor
+ * in the same dispatch pass */
+#define SCHEDULER_JOB_TRIGGERED 3U
+/** Job type: deferrable job, executed once upon the next wakeup of another job
+ * or at the latest after its maximum latency */
+#define SCHEDULER_JOB_DEFERRABLE 4U
+/** Job type: table job, made pending by the wakeup entries of the static
+ * schedule of the scheduler */
+#define SCHEDULER_JOB_TABLE 5U
+
+/** Maximum number of table jobs, i.e. the width of the pending masks of the
+ * static schedule */
+#define SCHEDULER_TABLE_MAX_JOBS 32U
+
+/** Calendar field value that matches any value, similarly to the masked fields
+ * of the RTC alarm */
+#define SCHEDULER_CALENDAR_ANY 0xFFU
+
+/** Bit of a weekday in a weekday mask, where the weekday is one of the
+ * RTC_WEEKDAY_MONDAY ... RTC_WEEKDAY_SUNDAY values of the RTC driver */
+#define SCHEDULER_WEEKDAY(weekday) (1U << (weekday))
+/** Weekday mask: every day of the week */
+#define SCHEDULER_WEEKDAYS_ALL 0xFEU
+/** Weekday mask: Monday to Friday */
+#define SCHEDULER_WEEKDAYS_WORKDAYS 0x3EU
+
+/** Minute of the day of a given time, used by the active windows */
+#define SCHEDULER_TIME_OF_DAY(hours, minutes) (((hours)*60U) + (minutes))
+/** Number of minutes of a day */
+#define SCHEDULER_MINUTES_PER_DAY 1440U
 
 /* Typedefs ------------------------------------------------------------------*/
-/** Shorthand type for callback functions */
-typedef void (*Callback_t)(void);
+/** Shorthand type for callback functions. The context is the pointer given upon
+ * adding the job. */
+typedef void (*Callback_t)(void* context);
+
+/** Type of the period fields of the jobs, see ::SCHEDULER_PERIOD_BITS */
+#if(SCHEDULER_PERIOD_BITS == 16U)
+typedef uint16_t SchedulerPeriod_t;
+#else
+typedef uint32_t SchedulerPeriod_t;
+#endif
+
+/** Opaque handle of a job. The handle contains the index of the job and a
+ * generation counter, thus the handle of a cancelled job is never mistaken for
+ * a job that has been added later into the same slot. */
+typedef uint32_t JobHandle_t;
 
 /* Structures ----------------------------------------------------------------*/
-/** Structure of a single job */
+#if(SCHEDULER_QUEUE == SCHEDULER_QUEUE_WHEEL)
+/** Structure linking a job into the timing wheel */
+typedef struct
+{
+    /** Index of the next job in the same slot */
+    uint16_t next;
+    /** Index of the previous job in the same slot */
+    uint16_t prev;
+    /** The slot containing the job: the level in the upper two bits and the
+     * slot index in the lower six bits */
+    uint8_t slot;
+} SchedulerQueueLink_t;
+
+/** Structure of the hierarchical timing wheel */
+typedef struct
+{
+    /** The time (Unix epoch) up to which the wheel has been advanced */
+    uint32_t time;
+    /** Bitmask of the non-empty slots on each level */
+    uint64_t occupied[SCHEDULER_WHEEL_LEVELS];
+    /** Index of the first job in each slot */
+    uint16_t slots[SCHEDULER_WHEEL_LEVELS][SCHEDULER_WHEEL_SLOTS];
+    /** Index of the first job that has expired, ordered by deadline */
+    uint16_t expired;
+    /** Index of the first job whose deadline is out of range of the wheel */
+    uint16_t overflow;
+} SchedulerQueue_t;
+#elif(SCHEDULER_QUEUE == SCHEDULER_QUEUE_PACKED)
+/** Structure of the packed queue. The remaining time of each job is kept in
+ * the lane of the job, i.e. at the index of the job, thus the jobs need no
+ * link into the queue. */
+typedef struct
+{
+    /** The time (Unix epoch) that the remaining times are relative to */
+    uint32_t time;
+    /** The remaining times in [s] of the jobs, two 16-bit lanes per word. A
+     * remaining time of 0xFFFF denotes a deadline out of range of the lane. */
+    uint32_t lanes[SCHEDULER_PACKED_LANES / 2U];
+    /** Bitmask of the jobs that are in the queue */
+    uint32_t members[SCHEDULER_PACKED_LANES / 32U];
+    /** Bitmask of the jobs whose deadlines are out of range of their lanes */
+    uint32_t far[SCHEDULER_PACKED_LANES / 32U];
+    /** Bitmask of the jobs in the queue whose lanes have reached zero, built
+     * once per wakeup */
+    uint32_t due[SCHEDULER_PACKED_LANES / 32U];
+    /** The index of the job with the earliest deadline found by the previous
+     * search, or ::SCHEDULER_NO_JOB if it needs to be searched */
+    uint16_t earliest;
+} SchedulerQueue_t;
+#else
+/** Structure linking a job into the heap */
+typedef struct
+{
+    /** The position of the job in the heap */
+    uint16_t position;
+    /** The index of the job at the position of the heap that equals the index
+     * of this job. The heap array is spread over the job table, thus the heap
+     * needs no storage besides the job storage. */
+    uint16_t entry;
+} SchedulerQueueLink_t;
+
+/** Structure of the binary min-heap */
+typedef struct
+{
+    /** The number of jobs in the heap. The root of the heap is the job that is
+     * due the earliest. */
+    uint16_t size;
+} SchedulerQueue_t;
+#endif
+
+/** Structure of the hot data of a single job, i.e. the fields that are read
+ * upon ordering the queue and upon selecting the ready jobs. The cold data of
+ * the job is kept in a separate ::JobData_t array, thus the jobs are packed
+ * more densely and each access to the queue touches fewer bytes of SRAM. */
+typedef struct
+{
+    /** The latest time (Unix epoch) of the next execution of the job, i.e.
+     * the nominal time of the next execution plus the slack of the job. The
+     * queue is ordered by this deadline. While the scheduler is stopped, the
+     * deadline is relative to the reference time of the scheduler. */
+    uint32_t deadline;
+    /** The request that is applied at the next processing step: the generation
+     * in the upper half-word and the type of request in the lower half-word */
+    volatile uint32_t request;
+    /** The delay in [s] of the first execution of a periodic or a one-shot
+     * job, or the offset in [s] of the executions of a calendar job from the
+     * multiples of its period */
+    uint32_t offset;
+    /** The period of the job in [s], or zero for a one-shot job */
+    SchedulerPeriod_t period;
+    /** Generation counter of the job slot, incremented upon release */
+    uint16_t generation;
+    /** The slack in [s] of the current deadline: the job may be executed up
+     * to this amount of time later than its nominal time */
+    uint16_t slack;
+    /** The minute of the day when the active window of the job opens */
+    uint16_t windowStart;
+    /** The minute of the day when the active window of the job closes */
+    uint16_t windowEnd;
+    /** Flag to indicate whether the job is scheduled */
+    uint8_t isActive;
+    /** Flag to indicate whether the job is paused, see ::SchedulerPauseJob() */
+    uint8_t isPaused;
+    /** The number of pending executions of the job */
+    volatile uint8_t pending;
+    /** The type of the job */
+    uint8_t type;
+    /** Weekday mask of the active window of the job */
+    uint8_t weekdays;
+    /** The priority class of the job, see ::SCHEDULER_PRIORITY_NORMAL */
+    uint8_t priority;
+    /** The maximum factor by which the wakeup governor may stretch the period
+     * of the job, see ::SchedulerSetJobStretchLimit() */
+    uint8_t stretchLimit;
+#if(SCHEDULER_QUEUE != SCHEDULER_QUEUE_PACKED)
+    /** Link of the job into the queue */
+    SchedulerQueueLink_t link;
+#endif
+} Job_t;
+
+/** Structure of the cold data of a single job, i.e. the callback, the links of
+ * the triggered jobs, the missed-deadline policy, the requested changes and
+ * the statistics of the job, which are not needed to order the queue */
 typedef struct
 {
-    /** The period of the job in [s] */
-    uint32_t period;
-    /** The current remaining time in [s] until the next execution of job */
-    uint32_t remainingTime;
-    /** Flag to indicate whether the job is pending for execution */
-    uint8_t isPending;
     /** Callback that is called when the job is pending for execution */
     Callback_t callback;
-} Job_t;
+    /** The context passed to the callback, or the object notified upon
+     * execution if the job has no callback, e.g. the handle of an RTOS task */
+    void* context;
+    /** The time (Unix epoch) of the next execution requested by
+     * ::SchedulerSetJobNextDeadline() */
+    volatile uint32_t requestedDeadline;
+    /** The active window requested by ::SchedulerSetJobWindow(): the start in
+     * bits 0..10, the end in bits 11..21 and the weekday mask in bits 24..31 */
+    volatile uint32_t requestedWindow;
+    /** The lateness in [s] of the latest execution of the job with respect to
+     * its anchored deadline, saturated at ::SCHEDULER_MAX_PERIOD */
+    SchedulerPeriod_t phaseError;
+    /** The period in [s] that the job has been added or rescheduled with, to
+     * which the backoff of the job is reset */
+    SchedulerPeriod_t basePeriod;
+    /** The period in [s] requested by ::SchedulerRescheduleJob() or by the
+     * backoff of the job, equal to the period if no change is pending */
+    volatile SchedulerPeriod_t requestedPeriod;
+    /** The slack in [s] requested by ::SchedulerSetJobSlack(), applied when
+     * the next deadline of the job is calculated */
+    volatile uint16_t requestedSlack;
+    /** The missed-deadline policy in the upper byte and the catch-up limit in
+     * the lower byte requested by ::SchedulerSetJobPolicy() */
+    volatile uint16_t requestedPolicy;
+    /** The index of the job after which this triggered job is executed, or
+     * ::SCHEDULER_NO_JOB */
+    uint16_t predecessor;
+    /** The index of the first triggered job executed after this job, or
+     * ::SCHEDULER_NO_JOB */
+    uint16_t firstSuccessor;
+    /** The index of the next triggered job of the same predecessor, or
+     * ::SCHEDULER_NO_JOB */
+    uint16_t nextSibling;
+    /** The declared worst-case execution time in [ms] of the callback of the
+     * job, used by the schedulability analysis */
+    uint16_t wcet;
+    /** The priority class requested by ::SchedulerSetJobPriority() */
+    volatile uint8_t requestedPriority;
+    /** The stretch limit requested by ::SchedulerSetJobStretchLimit() */
+    volatile uint8_t requestedStretchLimit;
+    /** The missed-deadline policy of the job */
+    uint8_t policy;
+    /** The maximum number of missed activations that are caught up with the
+     * ::SCHEDULER_POLICY_CATCH_UP policy */
+    uint8_t catchUpLimit;
+} JobData_t;
+
+/** Structure of the wakeup statistics of a scheduler */
+typedef struct
+{
+    /** The number of wakeups upon which jobs have been executed */
+    uint32_t wakeups;
+    /** The number of wakeups that the executed jobs would have needed at their
+     * nominal times, i.e. without slack */
+    uint32_t nominalWakeups;
+    /** The latest nominal time (Unix epoch) that has been counted */
+    uint32_t lastNominalTime;
+    /** The number of activations that have been missed, i.e. the deadlines
+     * that have passed before the jobs could be processed */
+    uint32_t missedActivations;
+    /** The number of executions that have been skipped by the
+     * ::SCHEDULER_POLICY_SKIP policy */
+    uint32_t skippedExecutions;
+    /** The number of times a job has become due while its previous execution
+     * was still pending, i.e. the callbacks could not keep up */
+    uint32_t overruns;
+    /** The number of times a ready job has been deferred to the next wakeup
+     * because the execution budget has been used up */
+    uint32_t deferredExecutions;
+    /** The number of deferrable jobs that have been executed upon the wakeup
+     * of another job, i.e. without a wakeup of their own */
+    uint32_t coalescedJobs;
+    /** The number of deadlines that have been stretched by the wakeup
+     * governor */
+    uint32_t stretchedActivations;
+    /** The total time in [s] by which the wakeup governor has stretched the
+     * deadlines */
+    uint32_t stretchedTime;
+    /** The number of allocations from the scratch arena that have failed
+     * because the arena has been exhausted */
+    uint32_t scratchFailures;
+    /** The current stretch level of the wakeup governor, zero if the periods
+     * are not stretched */
+    uint8_t governorLevel;
+    /** The largest number of bytes that have been allocated from the scratch
+     * arena within a single execution pass */
+    uint16_t scratchHighWater;
+} SchedulerStats_t;
+
+/** Structure of the limits and the power model of the schedulability
+ * analysis */
+typedef struct
+{
+    /** The time in [ms] spent awake upon each wakeup besides the callbacks,
+     * e.g. waking up from STOP2 mode and restoring the clocks */
+    uint32_t wakeupTime;
+    /** The current consumption in [uA] while the microcontroller is awake */
+    uint32_t activeCurrent;
+    /** The current consumption in [nA] in STOP2 mode */
+    uint32_t sleepCurrent;
+    /** The maximum utilization in [ppm] of the CPU, or zero to only reject an
+     * utilization above 100% */
+    uint32_t maxUtilization;
+    /** The maximum average current consumption in [nA], or zero if there is no
+     * energy budget */
+    uint32_t maxAverageCurrent;
+} SchedulerBudget_t;
 
-/** Structure of the scheduler */
+/** Structure of the result of the schedulability analysis */
 typedef struct
 {
-    /** The starting time (Unix epoch) denoting when the scheduler was launched
-     * or processed. */
-    uint32_t startTime;
+    /** The hyperperiod in [s] of the jobs, or zero if it exceeds 32 bits */
+    uint32_t hyperperiod;
+    /** The number of wakeups per hyperperiod */
+    uint32_t wakeups;
+    /** The worst-case awake time in [ms] per hyperperiod */
+    uint64_t awakeTime;
+    /** The worst-case utilization in [ppm] of the CPU, including the wakeups */
+    uint32_t utilization;
+    /** The worst-case average current consumption in [nA] */
+    uint32_t averageCurrent;
+} SchedulerAnalysis_t;
+
+/** Structure of a wakeup entry of a static schedule */
+typedef struct
+{
+    /** The time in [s] of the wakeup relative to the start of the
+     * hyperperiod, greater than zero and not greater than the hyperperiod */
+    uint32_t offset;
+    /** Bitmask of the table jobs that become pending upon the wakeup, where
+     * bit i refers to the job at index i */
+    uint32_t pending;
+} SchedulerTableEntry_t;
+
+/** Structure of a static schedule, generated offline from a fixed job set by
+ * the python/generate_schedule.py script */
+typedef struct
+{
+    /** The hyperperiod in [s] after which the schedule repeats itself */
+    uint32_t hyperperiod;
+    /** The number of wakeup entries per hyperperiod */
+    uint16_t count;
+    /** The wakeup entries ordered by their offsets */
+    const SchedulerTableEntry_t* entries;
+} SchedulerTable_t;
+
+/** Structure of a scheduler instance */
+typedef struct Scheduler_s
+{
+    /** The reference time (Unix epoch) denoting when the scheduler was
+     * stopped. Upon launching the scheduler, the deadlines of the jobs are
+     * shifted by the time elapsed since the reference time. */
+    uint32_t referenceTime;
     /** Flag to indicate whether the scheduler is running */
-    uint8_t isRunning;
-    /** The actual number of jobs that the scheduler is scheduling */
-    uint8_t numOfJobs;
-    /** Array containing the jobs */
-    Job_t jobs[MAX_NUM_OF_JOBS];
+    volatile uint8_t isRunning;
+    /** Start or stop request that is applied at the next processing step */
+    volatile uint32_t runRequest;
+    /** The maximum number of jobs of the scheduler */
+    uint16_t capacity;
+    /** Array containing the hot data of the jobs, provided by the
+     * application */
+    Job_t* jobs;
+    /** Array containing the cold data of the jobs, provided by the
+     * application */
+    JobData_t* jobData;
+    /** Bitmask of the job slots that are allocated */
+    volatile uint32_t* allocated;
+    /** Bitmask of the job slots that have a request to be applied */
+    volatile uint32_t* requests;
+    /** Bitmask of the jobs with a callback that are ready for execution. The
+     * bits are set by the processing and cleared by the execution of the
+     * pending jobs. */
+    volatile uint32_t* ready;
+    /** Bitmask of the jobs without a callback whose context needs to be
+     * notified */
+    volatile uint32_t* notify;
+    /** Bitmask of the scheduled deferrable jobs, only accessed by the
+     * processing */
+    volatile uint32_t* deferrable;
+    /** Queue containing the jobs ordered by their deadlines */
+    SchedulerQueue_t queue;
+    /** Wakeup statistics of the scheduler */
+    SchedulerStats_t stats;
+    /** Base period in [s] of the harmonic registration mode, or zero if the
+     * mode is disabled */
+    uint32_t harmonicBase;
+    /** Tolerance in [%] of the period snapping of the harmonic registration
+     * mode */
+    uint8_t harmonicTolerance;
+    /** The handle of the job whose callback is being executed, or
+     * ::SCHEDULER_INVALID_HANDLE */
+    JobHandle_t currentJob;
+    /** The execution budget in [ms] of the pending jobs per wakeup, or zero if
+     * the budget is disabled */
+    uint32_t executionBudget;
+    /** The scratch arena of the callbacks, provided by the application, or
+     * NULL if there is no arena */
+    uint8_t* scratch;
+    /** The size in bytes of the scratch arena */
+    uint16_t scratchSize;
+    /** The number of bytes allocated from the scratch arena in the current
+     * execution pass */
+    uint16_t scratchUsed;
+    /** The maximum number of wakeups per hour of the wakeup governor, or zero
+     * if the governor is disabled */
+    uint16_t wakeupBudget;
+    /** The number of wakeups since the start of the current governor window */
+    uint32_t governorWakeups;
+    /** The time (Unix epoch) of the start of the current governor window */
+    uint32_t governorWindowStart;
+    /** Flag to indicate whether a higher stretch level of the wakeup governor
+     * would stretch any job further */
+    uint8_t governorHeadroom;
+    /** The static schedule of the table jobs, or NULL if the table-driven
+     * mode is disabled */
+    const SchedulerTable_t* table;
+    /** The time (Unix epoch) of the start of the current hyperperiod of the
+     * static schedule. While the scheduler is stopped, the time is relative
+     * to the reference time of the scheduler. */
+    uint32_t tableCycleStart;
+    /** The position of the next wakeup entry of the static schedule */
+    uint16_t tablePosition;
+    /** Bitmask of the table jobs that are made ready by the static schedule,
+     * i.e. the allocated table jobs that are not paused. Only accessed by the
+     * processing. */
+    uint32_t tableJobs;
+    /** Bitmask of the table jobs without a callback, only accessed by the
+     * processing */
+    uint32_t tableNotify;
+    /** Bitmask of the table jobs with one pending execution that has not been
+     * added to their pending executions yet. The bits are set by the
+     * processing and cleared by the execution or the notification. */
+    volatile uint32_t tablePending;
+    /** Next scheduler instance attached to the RTC alarm multiplexer */
+    struct Scheduler_s* next;
 } Scheduler_t;
 
 /* Functions -----------------------------------------------------------------*/
-void SchedulerInit(void);
-uint8_t SchedulerAddJob(const uint32_t period, const Callback_t callback);
-void SchedulerProcess(void);
-void SchedulerExecutePendingJobs(void);
-void SchedulerStop(void);
+void SchedulerInit(Scheduler_t* const sched,
+                   Job_t* const jobs,
+                   JobData_t* const jobData,
+                   uint32_t* const bitmaps,
+                   const uint16_t capacity);
+JobHandle_t SchedulerAddJob(Scheduler_t* const sched,
+                            const uint32_t period,
+                            const Callback_t callback,
+                            void* const context);
+JobHandle_t SchedulerAddDelayedJob(Scheduler_t* const sched,
+                                   const uint32_t delay,
+                                   const uint32_t period,
+                                   const Callback_t callback,
+                                   void* const context);
+JobHandle_t SchedulerAddOneShotJob(Scheduler_t* const sched,
+                                   const uint32_t delay,
+                                   const Callback_t callback,
+                                   void* const context);
+JobHandle_t SchedulerAddDeferrableJob(Scheduler_t* const sched,
+                                      const uint32_t maxLatency,
+                                      const Callback_t callback,
+                                      void* const context);
+JobHandle_t SchedulerAddCalendarJob(Scheduler_t* const sched,
+                                    const uint8_t hours,
+                                    const uint8_t minutes,
+                                    const uint8_t seconds,
+                                    const uint8_t weekdays,
+                                    const Callback_t callback,
+                                    void* const context);
+JobHandle_t SchedulerAddTriggeredJob(Scheduler_t* const sched,
+                                     const JobHandle_t predecessor,
+                                     const Callback_t callback,
+                                     void* const context);
+JobHandle_t SchedulerAddTableJob(Scheduler_t* const sched,
+                                 const Callback_t callback,
+                                 void* const context);
+uint8_t SchedulerSetJobWindow(Scheduler_t* const sched,
+                              const JobHandle_t handle,
+                              const uint16_t start,
+                              const uint16_t end,
+                              const uint8_t weekdays);
+uint8_t SchedulerCancelJob(Scheduler_t* const sched, const JobHandle_t handle);
+uint8_t SchedulerRescheduleJob(Scheduler_t* const sched,
+                               const JobHandle_t handle,
+                               const uint32_t period);
+uint8_t SchedulerBackOffJob(Scheduler_t* const sched,
+                            const JobHandle_t handle,
+                            const uint8_t mode,
+                            const uint32_t maxPeriod);
+uint8_t SchedulerResetJobPeriod(Scheduler_t* const sched,
+                                const JobHandle_t handle);
+uint8_t SchedulerPauseJob(Scheduler_t* const sched, const JobHandle_t handle);
+uint8_t SchedulerResumeJob(Scheduler_t* const sched, const JobHandle_t handle);
+uint8_t SchedulerTriggerJob(Scheduler_t* const sched,
+                            const JobHandle_t handle,
+                            const uint8_t resetPhase);
+uint8_t SchedulerSetJobNextDeadline(Scheduler_t* const sched,
+                                    const JobHandle_t handle,
+                                    const uint32_t deadline);
+JobHandle_t SchedulerGetCurrentJob(const Scheduler_t* const sched);
+uint8_t SchedulerSetJobSlack(Scheduler_t* const sched,
+                             const JobHandle_t handle,
+                             const uint16_t slack);
+uint8_t SchedulerProcess(Scheduler_t* const sched,
+                         const uint32_t currentTime,
+                         uint32_t* const nextDeadline);
+void SchedulerExecutePendingJobs(Scheduler_t* const sched);
+uint8_t SchedulerHasPendingJobs(const Scheduler_t* const sched);
+uint8_t SchedulerTakeNotification(Scheduler_t* const sched,
+                                  void** const context,
+                                  uint8_t* const count);
+void SchedulerStart(Scheduler_t* const sched);
+void SchedulerStop(Scheduler_t* const sched);
+uint8_t SchedulerSetJobPolicy(Scheduler_t* const sched,
+                              const JobHandle_t handle,
+                              const uint8_t policy,
+                              const uint8_t catchUpLimit);
+void SchedulerGetStats(const Scheduler_t* const sched,
+                       SchedulerStats_t* const stats);
+uint32_t SchedulerGetSavedWakeups(const Scheduler_t* const sched);
+uint8_t SchedulerGetJobPhaseError(const Scheduler_t* const sched,
+                                  const JobHandle_t handle,
+                                  uint32_t* const phaseError);
+void SchedulerSetHarmonicMode(Scheduler_t* const sched,
+                              const uint32_t basePeriod,
+                              const uint8_t tolerance);
+void SchedulerSetTable(Scheduler_t* const sched,
+                       const SchedulerTable_t* const table);
+uint8_t SchedulerSetJobPriority(Scheduler_t* const sched,
+                                const JobHandle_t handle,
+                                const uint8_t priority);
+void SchedulerSetExecutionBudget(Scheduler_t* const sched,
+                                 const uint32_t budget);
+void SchedulerSetWakeupBudget(Scheduler_t* const sched,
+                              const uint16_t wakeupsPerHour);
+uint8_t SchedulerSetJobStretchLimit(Scheduler_t* const sched,
+                                    const JobHandle_t handle,
+                                    const uint8_t limit);
+uint8_t SchedulerSetJobWcet(Scheduler_t* const sched,
+                            const JobHandle_t handle,
+                            const uint16_t wcet);
+void SchedulerSetScratchArena(Scheduler_t* const sched,
+                              void* const arena,
+                              const uint16_t size);
+void* SchedulerScratchAlloc(Scheduler_t* const sched, const uint16_t size);
+uint8_t SchedulerGetHyperperiod(const Scheduler_t* const sched,
+                                uint32_t* const hyperperiod,
+                                uint32_t* const wakeups);
+uint8_t SchedulerAnalyze(const Scheduler_t* const sched,
+                         const SchedulerBudget_t* const budget,
+                         SchedulerAnalysis_t* const analysis);
+JobHandle_t SchedulerAdmitJob(Scheduler_t* const sched,
+                              const SchedulerBudget_t* const budget,
+                              const uint32_t period,
+                              const uint16_t wcet,
+                              const Callback_t callback,
+                              void* const context);
+uint8_t SchedulerGetNextWakeup(const Scheduler_t* const sched,
+                               const uint32_t after,
+                               uint32_t* const wakeup);
 
 #ifdef __cplusplus
 }
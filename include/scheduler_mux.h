@@ -0,0 +1,49 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_mux.h
+ * @brief   This file contains the function prototypes of the RTC alarm
+ *          multiplexer of the scheduler instances.
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+#ifndef SCHEDULER_MUX_H
+#define SCHEDULER_MUX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler.h"
+
+/* Defines -------------------------------------------------------------------*/
+/** The number of attempts to configure the RTC alarm upon processing. A failed
+ * attempt is retried if the deadline has passed meanwhile; if each attempt
+ * fails, e.g. due to a HAL error, the processing gives up. */
+#ifndef SCHEDULER_MUX_ALARM_ATTEMPTS
+#define SCHEDULER_MUX_ALARM_ATTEMPTS 4U
+#endif
+
+/* Functions -----------------------------------------------------------------*/
+void SchedulerMuxInit(void);
+void SchedulerMuxAttach(Scheduler_t* const sched);
+uint8_t SchedulerMuxProcess(void);
+void SchedulerMuxExecutePendingJobs(void);
+uint8_t SchedulerMuxTakeNotification(void** const context,
+                                     uint8_t* const count);
+uint8_t SchedulerMuxGetTimeUntilWakeup(uint32_t* const seconds,
+                                       uint16_t* const milliseconds);
+uint8_t SchedulerMuxGetNextWakeup(const uint32_t after, uint32_t* const wakeup);
+uint32_t SchedulerMuxGetAlarmErrors(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDULER_MUX_H */
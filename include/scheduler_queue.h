@@ -0,0 +1,39 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_queue.h
+ * @brief   This file contains the function prototypes of the queue backends
+ *          of the scheduler. The backend is selected at compile time with the
+ *          SCHEDULER_QUEUE define.
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+#ifndef SCHEDULER_QUEUE_H
+#define SCHEDULER_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler.h"
+
+/* Functions -----------------------------------------------------------------*/
+void SchedulerQueueInit(Scheduler_t* const sched, const uint32_t currentTime);
+void SchedulerQueueInsert(Scheduler_t* const sched, const uint16_t index);
+void SchedulerQueueRemove(Scheduler_t* const sched, const uint16_t index);
+uint8_t SchedulerQueuePeek(Scheduler_t* const sched, uint16_t* const index);
+uint8_t SchedulerQueuePopDue(Scheduler_t* const sched,
+                             const uint32_t currentTime,
+                             uint16_t* const index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDULER_QUEUE_H */
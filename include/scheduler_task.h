@@ -0,0 +1,37 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_task.h
+ * @brief   This file contains the function prototypes for binding the jobs of
+ *          the scheduler directly to RTOS tasks.
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+#ifndef SCHEDULER_TASK_H
+#define SCHEDULER_TASK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "scheduler.h"
+#include "task.h"
+
+/* Functions -----------------------------------------------------------------*/
+JobHandle_t SchedulerAddTaskJob(Scheduler_t* const sched,
+                                const uint32_t period,
+                                const TaskHandle_t task);
+void SchedulerTaskNotifyFromISR(BaseType_t* const higherPriorityTaskWoken);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDULER_TASK_H */
@@ -0,0 +1,61 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    wake_lock.h
+ * @brief   This file contains the data structures and function prototypes of
+ *          the wake locks that inhibit the STOP2 mode.
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+#ifndef WAKE_LOCK_H
+#define WAKE_LOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l4xx_hal.h"
+
+/* Typedefs ------------------------------------------------------------------*/
+/** Structure of the hold-time statistics of a wake lock */
+typedef struct
+{
+    /** The number of times the lock has been held, i.e. acquired while it was
+     * released */
+    uint32_t holds;
+    /** The total time in [ms] the lock has been held */
+    uint32_t totalHoldTime;
+    /** The longest time in [ms] the lock has been held at once */
+    uint32_t maxHoldTime;
+} WakeLockStats_t;
+
+/** Structure of a wake lock */
+typedef struct
+{
+    /** The number of acquisitions that have not been released yet */
+    volatile uint32_t count;
+    /** The HAL tick of the acquisition that has taken the lock */
+    volatile uint32_t holdStart;
+    /** The hold-time statistics of the lock */
+    WakeLockStats_t stats;
+} WakeLock_t;
+
+/* Functions -----------------------------------------------------------------*/
+void WakeLockInit(WakeLock_t* const lock);
+void WakeLockAcquire(WakeLock_t* const lock);
+void WakeLockRelease(WakeLock_t* const lock);
+uint8_t WakeLockIsAnyHeld(void);
+void WakeLockGetStats(const WakeLock_t* const lock,
+                      WakeLockStats_t* const stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WAKE_LOCK_H */
@@ -0,0 +1,172 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+import argparse
+import json
+import os
+import re
+from math import gcd
+
+# Limits of the SchedulerTable_t structure
+MAX_JOBS = 32
+MAX_ENTRIES = 0xFFFF
+MAX_HYPERPERIOD = 0xFFFFFFFF
+
+
+def load_jobs(path):
+    with open(path, "r") as f:
+        description = json.load(f)
+
+    jobs = description["jobs"]
+    if len(jobs) == 0 or len(jobs) > MAX_JOBS:
+        raise ValueError("The number of jobs must be between 1 and {}."
+                         .format(MAX_JOBS))
+
+    for job in jobs:
+        period = job["period"]
+        delay = job.get("delay", period)
+        if period <= 0 or delay <= 0 or delay > period:
+            raise ValueError("Job '{}': the period must be positive and the "
+                             "delay must be within (0, period]."
+                             .format(job["name"]))
+        job["delay"] = delay
+
+    return description.get("name", "schedule"), jobs
+
+
+def compute_hyperperiod(jobs):
+    hyperperiod = 1
+    for job in jobs:
+        hyperperiod = (hyperperiod * job["period"] //
+                       gcd(hyperperiod, job["period"]))
+    if hyperperiod > MAX_HYPERPERIOD:
+        raise ValueError("The hyperperiod exceeds 32 bits.")
+    return hyperperiod
+
+
+def count_wakeups(job, hyperperiod):
+    return (hyperperiod - job["delay"]) // job["period"] + 1
+
+
+def compute_entries(jobs, hyperperiod):
+    # The wakeups of a job are at delay + k * period. The offsets of the
+    # entries are within (0, hyperperiod], thus the schedule repeats itself
+    # after each hyperperiod.
+    error = ValueError("The schedule has more than {} entries."
+                       .format(MAX_ENTRIES))
+
+    # Each job has its own entry for each of its wakeups, thus the schedule
+    # is rejected before the entries are built if any job has too many
+    if max(count_wakeups(job, hyperperiod) for job in jobs) > MAX_ENTRIES:
+        raise error
+
+    # The entries are checked after each job, thus at most twice the limit of
+    # entries are built
+    entries = dict()
+    for bit, job in enumerate(jobs):
+        for offset in range(job["delay"], hyperperiod + 1, job["period"]):
+            entries[offset] = entries.get(offset, 0) | (1 << bit)
+        if len(entries) > MAX_ENTRIES:
+            raise error
+
+    return sorted(entries.items())
+
+
+def identifier(name):
+    return re.sub(r"[^0-9a-zA-Z_]", "_", name)
+
+
+def generate_header(name, jobs, header, source):
+    guard = identifier(header).upper()
+    lines = ["/**",
+             " * @file    {}".format(header),
+             " * @brief   Static schedule generated by generate_schedule.py "
+             "from",
+             " *          {}. Do not edit.".format(source),
+             " */",
+             "",
+             "#ifndef {}".format(guard),
+             "#define {}".format(guard),
+             "",
+             "#include \"scheduler.h\"",
+             "",
+             "/* Indices of the table jobs, to be added in this order by",
+             " * SchedulerAddTableJob() */"]
+    for bit, job in enumerate(jobs):
+        lines.append("#define {}_{} {}U".format(
+            identifier(name).upper(), identifier(job["name"]).upper(), bit))
+    lines += ["",
+              "extern const SchedulerTable_t {};".format(identifier(name)),
+              "",
+              "#endif /* {} */".format(guard),
+              ""]
+    return "\n".join(lines)
+
+
+def generate_source(name, jobs, hyperperiod, entries, header, source):
+    lines = ["/**",
+             " * @file    {}.c".format(os.path.splitext(header)[0]),
+             " * @brief   Static schedule generated by generate_schedule.py "
+             "from",
+             " *          {}. Do not edit.".format(source),
+             " *",
+             " * Hyperperiod: {} s, wakeups per hyperperiod: {}".format(
+                 hyperperiod, len(entries)),
+             " */",
+             "",
+             "#include \"{}\"".format(header),
+             "",
+             "/* Wakeup entries: offset in [s], pending mask of the jobs */",
+             "static const SchedulerTableEntry_t {}Entries[{}U] = {{".format(
+                 identifier(name), len(entries))]
+    for offset, mask in entries:
+        names = [job["name"] for bit, job in enumerate(jobs)
+                 if mask & (1 << bit)]
+        lines.append("    {{{}U, 0x{:08X}U}}, /* {} */".format(
+            offset, mask, ", ".join(names)))
+    lines += ["};",
+              "",
+              "const SchedulerTable_t {} = {{{}U, {}U, {}Entries}};".format(
+                  identifier(name), hyperperiod, len(entries),
+                  identifier(name)),
+              ""]
+    return "\n".join(lines)
+
+
+def generate_schedule(input, output):
+    name, jobs = load_jobs(input)
+    hyperperiod = compute_hyperperiod(jobs)
+    entries = compute_entries(jobs, hyperperiod)
+
+    base = os.path.splitext(output)[0]
+    header = os.path.basename(base) + ".h"
+    source = os.path.basename(input)
+
+    with open(base + ".h", "w") as f:
+        f.write(generate_header(name, jobs, header, source))
+    with open(base + ".c", "w") as f:
+        f.write(generate_source(name, jobs, hyperperiod, entries, header,
+                                source))
+
+    print("Generated {} wakeup entries over a hyperperiod of {} s into "
+          "{}.c and {}.h".format(len(entries), hyperperiod, base, base))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Static schedule generator for the table-driven mode of "
+                    "the scheduler")
+
+    # Job description
+    parser.add_argument("input",
+                        help="JSON job description, e.g. "
+                        "{\"name\": \"schedule\", \"jobs\": [{\"name\": "
+                        "\"led\", \"period\": 5, \"delay\": 5}]}")
+
+    # Output
+    parser.add_argument("-o", "--output",
+                        default="schedule.c",
+                        help="Path of the generated C source, the header is "
+                        "generated next to it (default is '%(default)s').")
+    args = parser.parse_args()
+
+    generate_schedule(args.input, args.output)
@@ -0,0 +1,153 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    atomic.c
+ * @brief   This file contains the implementation of the lock-free atomic
+ *          operations.
+ *
+ * The operations are built on the exclusive load and store instructions of the
+ * Cortex-M4 core, thus they can be called from tasks and interrupt handlers
+ * without masking interrupts. An exception entry or return clears the
+ * exclusive monitor, so an interrupted operation is simply retried.
+ *
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "atomic.h"
+
+/**
+ * @brief  Atomically set bits of a word.
+ *
+ * @param address  Pointer to the word.
+ * @param mask     The bits to be set.
+ * @return  The value of the word before the operation.
+ */
+uint32_t AtomicFetchOr(volatile uint32_t* const address, const uint32_t mask)
+{
+    uint32_t value = 0U;
+
+    do
+    {
+        value = __LDREXW(address);
+    } while(__STREXW(value | mask, address) != 0U);
+    __DMB();
+
+    return value;
+}
+
+/**
+ * @brief  Atomically clear bits of a word.
+ *
+ * @param address  Pointer to the word.
+ * @param mask     The bits to be kept; the other bits are cleared.
+ * @return  The value of the word before the operation.
+ */
+uint32_t AtomicFetchAnd(volatile uint32_t* const address, const uint32_t mask)
+{
+    uint32_t value = 0U;
+
+    do
+    {
+        value = __LDREXW(address);
+    } while(__STREXW(value & mask, address) != 0U);
+    __DMB();
+
+    return value;
+}
+
+/**
+ * @brief  Atomically add a value to a word. A value can be subtracted by adding
+ *         its two's complement.
+ *
+ * @param address  Pointer to the word.
+ * @param value    The value to be added.
+ * @return  The value of the word before the operation.
+ */
+uint32_t AtomicFetchAdd(volatile uint32_t* const address, const uint32_t value)
+{
+    uint32_t previous = 0U;
+
+    do
+    {
+        previous = __LDREXW(address);
+    } while(__STREXW(previous + value, address) != 0U);
+    __DMB();
+
+    return previous;
+}
+
+/**
+ * @brief  Atomically replace the value of a word.
+ *
+ * @param address  Pointer to the word.
+ * @param value    The new value of the word.
+ * @return  The value of the word before the operation.
+ */
+uint32_t AtomicExchange(volatile uint32_t* const address, const uint32_t value)
+{
+    uint32_t previous = 0U;
+
+    do
+    {
+        previous = __LDREXW(address);
+    } while(__STREXW(value, address) != 0U);
+    __DMB();
+
+    return previous;
+}
+
+/**
+ * @brief  Atomically replace the value of a byte.
+ *
+ * @param address  Pointer to the byte.
+ * @param value    The new value of the byte.
+ * @return  The value of the byte before the operation.
+ */
+uint8_t AtomicExchangeByte(volatile uint8_t* const address, const uint8_t value)
+{
+    uint8_t previous = 0U;
+
+    do
+    {
+        previous = __LDREXB(address);
+    } while(__STREXB(value, address) != 0U);
+    __DMB();
+
+    return previous;
+}
+
+/**
+ * @brief  Atomically replace the value of a word if it equals an expected
+ *         value.
+ *
+ * @param address   Pointer to the word.
+ * @param expected  The expected value of the word.
+ * @param desired   The new value of the word.
+ * @return  A non-zero value if the word has been replaced; otherwise zero.
+ */
+uint8_t AtomicCompareExchange(volatile uint32_t* const address,
+                              const uint32_t expected,
+                              const uint32_t desired)
+{
+    uint8_t result = 0U;
+
+    do
+    {
+        if(__LDREXW(address) != expected)
+        {
+            __CLREX();
+            result = 0U;
+            break;
+        }
+        result = 1U;
+    } while(__STREXW(desired, address) != 0U);
+    __DMB();
+
+    return result;
+}
@@ -16,6 +16,7 @@
 #include "core_stop.h"
 #include "hardware.h"
 #include "rtc.h"
+#include "wake_lock.h"
 
 /* Private variables ---------------------------------------------------------*/
 /** Variable to track whether the core has stopped and entered into STOP mode */
@@ -27,6 +28,18 @@ static volatile uint8_t isCoreStopped = 0U;
  * This funtion suspends the SysTick, deinitializes all previously initialized
  * peripherals (except the RTC), resets the clock configuration and puts the MCU
  * into STOP2 mode. The RTC remains running in STOP2 mode.
+ *
+ * The wake locks are checked again after the interrupts have been masked, since
+ * an interrupt handler, or a task woken by it, may have acquired a wake lock
+ * and started a transfer after the idle hook has checked them. In that case,
+ * the function enters into sleep mode instead, thus the peripherals keep
+ * running. The interrupts that are masked during the entry stay masked until
+ * the MCU has been woken up, thus their handlers cannot acquire a wake lock
+ * after the peripherals have been deinitialized; a pending interrupt wakes up
+ * the MCU immediately instead.
+ *
+ * @note  The wake locks must only be acquired from interrupt handlers whose
+ *        priority is not higher than the priority of the RTOS tick.
  */
 void EnterStop2Mode(void)
 {
@@ -35,45 +48,90 @@ void EnterStop2Mode(void)
     __DSB();
     __ISB();
 
-    /* Set core stop flag */
-    isCoreStopped = 1U;
-
-    /* Suspend RTOS Systick */
-    CLEAR_BIT(SysTick->CTRL, SysTick_CTRL_ENABLE_Msk);
-
-    /* Reset system clock to MSI */
-    HAL_RCC_DeInit();
-
-    /* Suspend HAL tick interrupt */
-    HAL_SuspendTick();
-
-    /* Set configured GPIOs to analog mode
-     * Note: further reduction in current consumption can be reached by setting
-     * all pins of the MCU (including the debugging pins) to analog mode. */
-    GpioDeinit();
-
-    /* Disable peripheral clocks */
-    __HAL_RCC_FLASH_CLK_DISABLE();
-    __HAL_RCC_PWR_CLK_DISABLE();
-    __HAL_RCC_SYSCFG_CLK_DISABLE();
+    if(WakeLockIsAnyHeld() != 0U)
+    {
+        /* A wake lock has been acquired meanwhile: keep the peripherals
+         * running */
+        __set_BASEPRI(0);
+        EnterSleepMode();
+    }
+    else
+    {
+        /* Set core stop flag */
+        isCoreStopped = 1U;
+
+        /* Suspend RTOS Systick */
+        CLEAR_BIT(SysTick->CTRL, SysTick_CTRL_ENABLE_Msk);
+
+        /* Reset system clock to MSI */
+        HAL_RCC_DeInit();
+
+        /* Suspend HAL tick interrupt */
+        HAL_SuspendTick();
+
+        /* Set configured GPIOs to analog mode
+         * Note: further reduction in current consumption can be reached by
+         * setting all pins of the MCU (including the debugging pins) to analog
+         * mode. */
+        GpioDeinit();
+
+        /* Disable peripheral clocks */
+        __HAL_RCC_FLASH_CLK_DISABLE();
+        __HAL_RCC_PWR_CLK_DISABLE();
+        __HAL_RCC_SYSCFG_CLK_DISABLE();
+
+        RCC->AHB1SMENR  = 0U;
+        RCC->AHB2SMENR  = 0U;
+        RCC->AHB3SMENR  = 0U;
+        RCC->APB1SMENR1 = 0U;
+        RCC->APB1SMENR2 = 0U;
+        RCC->APB2SMENR  = 0U;
+
+        /* Ensure that MSI is the wake-up system clock */
+        __HAL_RCC_PWR_CLK_ENABLE();
+        HAL_RCCEx_WakeUpStopCLKConfig(RCC_STOP_WAKEUPCLOCK_MSI);
+
+        /* Keep the pending interrupts masked until the wakeup: a pending
+         * interrupt prevents the MCU from entering into STOP2 mode */
+        __disable_irq();
+        __set_BASEPRI(0);
 
-    RCC->AHB1SMENR  = 0U;
-    RCC->AHB2SMENR  = 0U;
-    RCC->AHB3SMENR  = 0U;
-    RCC->APB1SMENR1 = 0U;
-    RCC->APB1SMENR2 = 0U;
-    RCC->APB2SMENR  = 0U;
+        /* Enter Stop2 */
+        __HAL_RCC_PWR_CLK_ENABLE();
+        HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
 
-    /* Ensure that MSI is the wake-up system clock */
-    __HAL_RCC_PWR_CLK_ENABLE();
-    HAL_RCCEx_WakeUpStopCLKConfig(RCC_STOP_WAKEUPCLOCK_MSI);
+        /* Re-enable interrupts: the interrupt that has woken up the MCU is
+         * handled */
+        __enable_irq();
+    }
+}
 
-    /* Re-enable interrupts */
-    __set_BASEPRI(0);
+/**
+ * @brief  Enter into sleep mode.
+ *
+ * Only the clock of the core is stopped, while the clocks, the peripherals and
+ * the DMA keep running, thus an ongoing transfer is not interrupted. The core
+ * is woken up by any interrupt, including the RTOS tick, and no resume is
+ * needed.
+ */
+void EnterSleepMode(void)
+{
+    HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+}
 
-    /* Enter Stop2 */
-    __HAL_RCC_PWR_CLK_ENABLE();
-    HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+/**
+ * @brief  Check whether the core has been stopped and not resumed yet.
+ *
+ * The function can be used by the interrupt handlers that wake up the MCU to
+ * decide whether the clocks and the peripherals are still in their STOP2 mode
+ * configuration, i.e. whether the MCU runs from the MSI clock.
+ *
+ * @return  A non-zero value if the core has not been resumed from STOP2 mode
+ *          yet; otherwise zero.
+ */
+uint8_t IsCoreStopped(void)
+{
+    return isCoreStopped;
 }
 
 /**
@@ -117,3 +175,36 @@ void ResumeFromStop2Mode(void)
         /* Do nothing when core is running */
     }
 }
+
+/**
+ * @brief  Check whether entering into STOP2 mode is worth its cost.
+ *
+ * Entering into and resuming from STOP2 mode costs time and energy, which is
+ * only recovered if the MCU stays in STOP2 mode for at least
+ * ::STOP2_BREAK_EVEN_TIME. A shorter idle period is spent in sleep mode.
+ *
+ * @param seconds       The whole seconds of the expected time in STOP2 mode.
+ * @param milliseconds  The sub-second part of the expected time in [ms].
+ * @return  A non-zero value if entering into STOP2 mode is worth its cost;
+ *          otherwise zero.
+ */
+uint8_t IsStop2ModeWorthwhile(const uint32_t seconds,
+                              const uint16_t milliseconds)
+{
+    uint8_t result = 0U;
+
+    if(seconds > (STOP2_BREAK_EVEN_TIME / 1000U))
+    {
+        result = 1U;
+    }
+    else if(((seconds * 1000U) + milliseconds) >= STOP2_BREAK_EVEN_TIME)
+    {
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
@@ -5,8 +5,8 @@
  * @author  Akos Pasztor
  * @file    main.c
  * @brief   This file contains the main application implementation, including
- *          the RTOS task implementations, RTOS hooks and scheduler callback
- *          implementations.
+ *          the RTOS task implementations, RTOS hooks and the jobs of the
+ *          scheduler.
  * @see     Please refer to README for detailed information.
  *******************************************************************************
  * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
@@ -21,8 +21,11 @@
 #include "hardware.h"
 #include "rtc.h"
 #include "scheduler.h"
+#include "scheduler_mux.h"
+#include "scheduler_task.h"
 #include "task.h"
 #include "timers.h"
+#include "wake_lock.h"
 
 /* Private variables ---------------------------------------------------------*/
 /** RTOS task handle for the blinking LED task */
@@ -31,12 +34,27 @@ TaskHandle_t taskHandleLedBlink = NULL;
 /** RTOS task handle for the steady LED task */
 TaskHandle_t taskHandleLedSteady = NULL;
 
+/** RTOS task handle for the scheduler dispatcher task */
+TaskHandle_t taskHandleSchedulerDispatcher = NULL;
+
+/** The scheduler instance of the application */
+Scheduler_t scheduler;
+
+/** The job storage of the scheduler instance */
+SCHEDULER_STORAGE_DEFINE(schedulerStorage, 2U);
+
+#ifdef RTC_ALARM_IRQ_PROFILING
+/** The worst-case execution time of a pass of the dispatcher task in CPU
+ * cycles, measured by the DWT cycle counter that is enabled by the RTC alarm
+ * interrupt handler. This is the work that the interrupt handler did before
+ * the dispatch was deferred to the task. */
+volatile uint32_t dispatcherMaxCycles = 0U;
+#endif
+
 /* Private function prototypes -----------------------------------------------*/
 void TaskLedBlink(void* arg);
 void TaskLedSteady(void* arg);
-
-void JobShortPeriodCallback(void);
-void JobLongPeriodCallback(void);
+void TaskSchedulerDispatcher(void* arg);
 
 /* External functions --------------------------------------------------------*/
 extern TickType_t GetExpectedIdleTime(void);
@@ -54,10 +72,9 @@ int main(void)
     SystemClockConfig();
     GpioInit();
     RtcInit();
-    SchedulerInit();
-
-    SchedulerAddJob(5U, JobShortPeriodCallback);
-    SchedulerAddJob(10U, JobLongPeriodCallback);
+    SchedulerMuxInit();
+    SCHEDULER_INIT(&scheduler, schedulerStorage);
+    SchedulerMuxAttach(&scheduler);
 
     if(xTaskCreate(TaskLedBlink,             /* Task function */
                    "task_led_blink",         /* Task name */
@@ -79,6 +96,20 @@ int main(void)
         ErrorHandler();
     }
 
+    if(xTaskCreate(TaskSchedulerDispatcher,  /* Task function */
+                   "task_dispatcher",        /* Task name */
+                   configMINIMAL_STACK_SIZE, /* Stack size */
+                   NULL,                     /* Arguments */
+                   3,                        /* Task priority */
+                   &taskHandleSchedulerDispatcher) != pdPASS)
+    {
+        ErrorHandler();
+    }
+
+    /* Bind the jobs directly to the tasks they unblock */
+    SchedulerAddTaskJob(&scheduler, 5U, taskHandleLedBlink);
+    SchedulerAddTaskJob(&scheduler, 10U, taskHandleLedSteady);
+
     /* RTOS Kernel Start */
     vTaskStartScheduler();
 
@@ -86,52 +117,13 @@ int main(void)
     ErrorHandler();
 }
 
-/**
- * @brief The callback function for the short period job.
- *
- * This function is called when the job with short period is pending. The
- * function unblocks the blinking LED RTOS task.
- *
- * @warning  The function is executed within an interrupt context. Therefore,
- *           this function must not block, furthermore only interrupt-safe RTOS
- *           API calls are allowed.
- */
-void JobShortPeriodCallback(void)
-{
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-
-    /* Unblock the Led Blink Task */
-    vTaskNotifyGiveFromISR(taskHandleLedBlink, &xHigherPriorityTaskWoken);
-
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-}
-
-/**
- * @brief The callback function for the long period job.
- *
- * This function is called when the job with long period is pending. The
- * function unblocks the steady LED RTOS task.
- *
- * @warning  The function is executed within an interrupt context. Therefore,
- *           this function must not block, furthermore only interrupt-safe RTOS
- *           API calls are allowed.
- */
-void JobLongPeriodCallback(void)
-{
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-
-    /* Unblock the Led Steady Task */
-    vTaskNotifyGiveFromISR(taskHandleLedSteady, &xHigherPriorityTaskWoken);
-
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-}
-
 /**
  * @brief  This function implements the blinking LED RTOS task.
  *
  * This task waits for an RTOS task notification to unblock. The notification is
- * given in the callback function of the short period job. The task blinks the
- * LD3 LED twice, then waits until the task is unblocked again.
+ * given by the RTC alarm interrupt handler when the short period job is due.
+ * The task blinks the LD3 LED twice, then waits until the task is unblocked
+ * again.
  *
  * @param arg  The RTOS task argument.
  */
@@ -158,9 +150,9 @@ void TaskLedBlink(void* arg)
  * @brief  This function implements the steady LED RTOS task.
  *
  * This task waits for an RTOS task notification to unblock. The notification is
- * given in the callback function of the long period job. The task turns on the
- * LD2 LED, waits 1 second, turns off the LD2 LED, then waits until the task is
- * unblocked again.
+ * given by the RTC alarm interrupt handler when the long period job is due. The
+ * task turns on the LD2 LED, waits 1 second, turns off the LD2 LED, then waits
+ * until the task is unblocked again.
  *
  * @param arg  The RTOS task argument.
  */
@@ -181,6 +173,52 @@ void TaskLedSteady(void* arg)
     }
 }
 
+/**
+ * @brief  This function implements the scheduler dispatcher RTOS task.
+ *
+ * This task waits for an RTOS task notification to unblock. The notification is
+ * given by the RTC alarm interrupt handler if jobs with a callback are ready
+ * for execution, or if the MCU has been woken up from STOP2 mode. The task
+ * restores the clock configuration if the MCU has been woken up from STOP2
+ * mode, then executes the callbacks of the pending jobs. Thus the interrupt
+ * handler does not block the other interrupts during the clock restoration and
+ * the callbacks. The task has a higher priority than the application tasks, so
+ * that the clocks are restored before they run, but a lower priority than the
+ * RTOS timer/daemon task.
+ *
+ * @param arg  The RTOS task argument.
+ */
+void TaskSchedulerDispatcher(void* arg)
+{
+    UNUSED(arg);
+    uint32_t isTaskUnblocked;
+
+    for(;;)
+    {
+        isTaskUnblocked = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if(isTaskUnblocked != 0U)
+        {
+#ifdef RTC_ALARM_IRQ_PROFILING
+            const uint32_t startCycles = DWT->CYCCNT;
+#endif
+
+            /* Resume operation from STOP2 mode */
+            ResumeFromStop2Mode();
+
+            /* Execute the pending jobs */
+            SchedulerMuxExecutePendingJobs();
+
+#ifdef RTC_ALARM_IRQ_PROFILING
+            const uint32_t cycles = DWT->CYCCNT - startCycles;
+            if(cycles > dispatcherMaxCycles)
+            {
+                dispatcherMaxCycles = cycles;
+            }
+#endif
+        }
+    }
+}
+
 /**
  * @brief  RTOS daemon startup callback.
  *
@@ -189,7 +227,7 @@ void TaskLedSteady(void* arg)
  */
 void vApplicationDaemonTaskStartupHook(void)
 {
-    SchedulerProcess();
+    SchedulerStart(&scheduler);
 }
 
 /**
@@ -199,17 +237,36 @@ void vApplicationDaemonTaskStartupHook(void)
  * call, the function asks the RTOS kernel what is the expected idle time and
  * whether the delayed task list is empty. If the expected idle time is greater
  * than a specified duration and the delayed task list is empty, the function
- * enters into STOP2 mode.
+ * enters into STOP2 mode. While a wake lock is held, e.g. by a job waiting for
+ * the completion of a transfer, or if the next wakeup by the scheduler is too
+ * close to be worth the cost of STOP2 mode, the function only enters into sleep
+ * mode. The RTC alarm wakes up the MCU from both modes. Since a wake lock may
+ * be acquired after this check, the locks are checked again upon entering into
+ * STOP2 mode with the interrupts masked.
  */
 void vApplicationIdleHook(void)
 {
     const uint32_t expectedIdleTime = GetExpectedIdleTime();
+    uint32_t seconds                = 0U;
+    uint16_t milliseconds           = 0U;
 
-    if((expectedIdleTime > pdMS_TO_TICKS(IDLE_TIME_BEFORE_SLEEP)) &&
-       (IsDelayedTaskListEmpty() == pdTRUE))
+    if(expectedIdleTime > pdMS_TO_TICKS(IDLE_TIME_BEFORE_SLEEP))
     {
-        EnterStop2Mode();
-        ResumeFromStop2Mode();
+        if((WakeLockIsAnyHeld() != 0U) ||
+           ((SchedulerMuxGetTimeUntilWakeup(&seconds, &milliseconds) != 0U) &&
+            (IsStop2ModeWorthwhile(seconds, milliseconds) == 0U)))
+        {
+            EnterSleepMode();
+        }
+        else if(IsDelayedTaskListEmpty() == pdTRUE)
+        {
+            EnterStop2Mode();
+            ResumeFromStop2Mode();
+        }
+        else
+        {
+            /* Tasks are delayed by the RTOS tick */
+        }
     }
 }
 
@@ -75,19 +75,37 @@ void RtcInit(void)
 /**
  * @brief  Get the current epoch.
  *
+ * @return  The current epoch in [s].
+ */
+uint32_t RtcGetEpoch(void)
+{
+    uint16_t milliseconds = 0U;
+
+    return RtcGetEpochWithFraction(&milliseconds);
+}
+
+/**
+ * @brief  Get the current epoch and the fraction of the current second.
+ *
  * This function retrieves the date and time from the RTC registers and converts
- * the values into Unix epoch.
+ * the values into Unix epoch. The sub-second register counts down from the
+ * synchronous prescaler value, thus the elapsed fraction of the second is
+ * derived from the difference of the two.
  *
  * @see     https://www.epochconverter.com/programming/c
+ * @param milliseconds  Pointer where the elapsed part of the current second is
+ *                      written in [ms].
  * @return  The current epoch in [s].
  */
-uint32_t RtcGetEpoch(void)
+uint32_t RtcGetEpochWithFraction(uint16_t* const milliseconds)
 {
     RTC_DateTypeDef date;
     RTC_TimeTypeDef time;
     struct tm dateTime;
     static time_t epoch;
 
+    assert_param(milliseconds != NULL);
+
     HAL_RTC_GetTime(&hrtc, &time, RTC_FORMAT_BIN);
     HAL_RTC_GetDate(&hrtc, &date, RTC_FORMAT_BIN);
 
@@ -101,6 +119,19 @@ uint32_t RtcGetEpoch(void)
 
     epoch = mktime(&dateTime);
 
+    /* The sub-second value may exceed the second fraction right after a shift
+     * operation; the fraction is limited to the current second in that case */
+    if(time.SubSeconds <= time.SecondFraction)
+    {
+        *milliseconds =
+            (uint16_t)(((time.SecondFraction - time.SubSeconds) * 1000U) /
+                       (time.SecondFraction + 1U));
+    }
+    else
+    {
+        *milliseconds = 0U;
+    }
+
     return (uint32_t)epoch;
 }
 
@@ -191,6 +222,18 @@ void RtcDeactivateAlarm(void)
     HAL_RTC_DeactivateAlarm(&hrtc, RTC_ALARM_A);
 }
 
+/**
+ * @brief  Trigger the RTC alarm interrupt by software.
+ *
+ * This function sets the RTC alarm interrupt pending, thus the interrupt
+ * handler is executed as soon as the interrupt priority allows, regardless of
+ * the configured alarm.
+ */
+void RtcTriggerAlarmInterrupt(void)
+{
+    HAL_NVIC_SetPendingIRQ(RTC_Alarm_IRQn);
+}
+
 /**
  * @brief  This function waits until the RTC time and date registers are
  *         synchronized with RTC APB clock. This function needs to be called
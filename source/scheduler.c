@@ -13,224 +13,3511 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "scheduler.h"
+#include "atomic.h"
 #include "rtc.h"
+#include "scheduler_queue.h"
 
-/* Private variables ---------------------------------------------------------*/
-/** The scheduler object */
-Scheduler_t scheduler;
+/* Private defines -----------------------------------------------------------*/
+/** Request type: no request */
+#define REQUEST_NONE 0U
+/** Request type: schedule a newly added job */
+#define REQUEST_ADD 1U
+/** Request type: cancel a job */
+#define REQUEST_CANCEL SCHEDULER_REQUEST_CANCEL
+/** Request type: change the period of a job */
+#define REQUEST_RESCHEDULE 3U
+/** Request type: change the period of a job keeping its phase */
+#define REQUEST_ADAPT 4U
+/** Request type: move the next deadline of a job */
+#define REQUEST_DEADLINE 5U
+/** Request type: pause a job */
+#define REQUEST_PAUSE 6U
+/** Request type: resume a paused job */
+#define REQUEST_RESUME 7U
+/** Request type: execute a job immediately */
+#define REQUEST_TRIGGER 8U
+/** Request type: execute a job immediately and restart its period */
+#define REQUEST_RESTART 9U
+/** Request flag: the job is scheduled as a newly added job before the request
+ * is applied, since its addition has been replaced by the request */
+#define REQUEST_ADD_PENDING 0x8000U
+
+/** Run request: none */
+#define RUN_REQUEST_NONE 0U
+/** Run request: start the scheduler */
+#define RUN_REQUEST_START 1U
+/** Run request: stop the scheduler */
+#define RUN_REQUEST_STOP 2U
+
+/** Number of seconds of a day */
+#define SECONDS_PER_DAY 86400U
+/** Number of seconds of an hour */
+#define SECONDS_PER_HOUR 3600U
+/** Number of seconds of a minute */
+#define SECONDS_PER_MINUTE 60U
+/** Maximum stretch level of the wakeup governor. At each level, the periods of
+ * the jobs of one more priority class are doubled. */
+#define GOVERNOR_MAX_LEVEL 9U
+
+/** Maximum number of window openings that are examined when searching for the
+ * next execution of a job within its active window */
+#define WINDOW_MAX_STEPS 64U
+
+/** Create a request word from a request type and a generation */
+#define REQUEST_MAKE(type, generation)                                         \
+    (((uint32_t)(generation) << 16U) | (uint32_t)(type))
+
+/** Get the request type of a request word */
+#define REQUEST_TYPE(request) ((request) & 0x7FFFU)
+
+/** Create a requested window word from the start, the end and the weekday mask
+ * of an active window */
+#define WINDOW_MAKE(start, end, weekdays)                                      \
+    ((uint32_t)(start) | ((uint32_t)(end) << 11U) |                            \
+     ((uint32_t)(weekdays) << 24U))
+
+/** Create a requested policy half-word from a policy and a catch-up limit */
+#define POLICY_MAKE(policy, catchUpLimit)                                      \
+    (uint16_t)(((uint32_t)(policy) << 8U) | (uint32_t)(catchUpLimit))
+
+/** Create a job handle from a job index and a generation */
+#define HANDLE_MAKE(index, generation)                                         \
+    (((uint32_t)(generation) << 16U) | (uint32_t)(index))
 
 /* Private function prototypes -----------------------------------------------*/
-void Scheduler_ProcessRemainingTime(const uint32_t elapsedTime);
+uint_fast8_t Scheduler_FindFirstSet(const uint32_t word);
+uint8_t Scheduler_AllocateJob(Scheduler_t* const sched, uint16_t* const index);
+JobHandle_t Scheduler_AddJob(Scheduler_t* const sched,
+                             const uint8_t type,
+                             const uint32_t period,
+                             const uint32_t offset,
+                             const uint8_t weekdays,
+                             const uint16_t predecessor,
+                             const Callback_t callback,
+                             void* const context);
+uint8_t Scheduler_GetJob(const Scheduler_t* const sched,
+                         const JobHandle_t handle,
+                         uint16_t* const index);
+uint8_t Scheduler_PostRequest(Scheduler_t* const sched,
+                              const uint16_t index,
+                              const uint32_t type);
+void Scheduler_PostRelease(Scheduler_t* const sched, const uint16_t index);
+void Scheduler_PostSettings(Scheduler_t* const sched, const uint16_t index);
+void Scheduler_ApplyRequests(Scheduler_t* const sched,
+                             const uint32_t currentTime);
+void Scheduler_ApplySettings(Scheduler_t* const sched, const uint16_t index);
+void Scheduler_ScheduleJob(Scheduler_t* const sched,
+                           const uint16_t index,
+                           const uint32_t baseTime);
+void Scheduler_ReleaseJob(Scheduler_t* const sched, const uint16_t index);
+void Scheduler_LinkJob(Scheduler_t* const sched, const uint16_t index);
+void Scheduler_UnlinkJob(Scheduler_t* const sched, const uint16_t index);
+void Scheduler_ExecuteSuccessors(Scheduler_t* const sched,
+                                 const uint16_t index);
+void Scheduler_Start(Scheduler_t* const sched, const uint32_t currentTime);
+void Scheduler_Stop(Scheduler_t* const sched, const uint32_t currentTime);
+void Scheduler_ProcessDueJobs(Scheduler_t* const sched,
+                              const uint32_t currentTime);
+void Scheduler_ProcessDeferrableJobs(Scheduler_t* const sched);
+uint8_t Scheduler_ProcessTable(Scheduler_t* const sched,
+                               const uint32_t currentTime);
+uint8_t Scheduler_ProcessLateTable(Scheduler_t* const sched,
+                                   const uint32_t currentTime);
+void Scheduler_SetTableJobsReady(Scheduler_t* const sched, const uint32_t jobs);
+void Scheduler_SetTableJobPending(Scheduler_t* const sched,
+                                  const uint16_t index,
+                                  const uint32_t missed);
+void Scheduler_SetTableJob(Scheduler_t* const sched,
+                           const uint16_t index,
+                           const uint8_t isEligible);
+uint8_t Scheduler_TakeTableExecution(Scheduler_t* const sched,
+                                     const uint16_t index);
+void Scheduler_UpdateGovernor(Scheduler_t* const sched,
+                              const uint32_t currentTime);
+uint32_t Scheduler_GetStretchedPeriod(Scheduler_t* const sched,
+                                      const Job_t* const job);
+uint32_t Scheduler_GetStretchFactor(const Job_t* const job,
+                                    const uint32_t level);
+void Scheduler_SetJobPending(Scheduler_t* const sched,
+                             const uint16_t index,
+                             const uint32_t currentTime);
+void Scheduler_ApplyPolicy(Scheduler_t* const sched,
+                           const uint16_t index,
+                           const uint32_t missed);
+void Scheduler_SetJobReady(Scheduler_t* const sched, const uint16_t index);
+uint16_t Scheduler_SelectReadyJob(const Scheduler_t* const sched);
+uint32_t Scheduler_CountReadyJobs(const Scheduler_t* const sched);
+uint32_t Scheduler_SnapPeriod(const Scheduler_t* const sched,
+                              const uint32_t period);
+uint8_t Scheduler_GetFirstDeadline(const Scheduler_t* const sched,
+                                   const Job_t* const job,
+                                   const uint32_t baseTime,
+                                   uint32_t* const deadline);
+void Scheduler_AdaptJob(Scheduler_t* const sched,
+                        const uint16_t index,
+                        const uint32_t type,
+                        const uint32_t baseTime);
+void Scheduler_ResumeJob(Scheduler_t* const sched,
+                         const uint16_t index,
+                         const uint32_t baseTime);
+void Scheduler_TriggerJob(Scheduler_t* const sched,
+                          const uint16_t index,
+                          const uint32_t type,
+                          const uint32_t baseTime);
+uint8_t Scheduler_ApplyWindow(const Job_t* const job, uint32_t* const time);
+uint32_t Scheduler_GetWindowOpening(const Job_t* const job,
+                                    const uint32_t time);
+
+/**
+ * @brief  Initialize a scheduler instance with the job storage provided by the
+ *         application and set its structure values to zero.
+ *
+ * The storage is usually defined by the ::SCHEDULER_STORAGE_DEFINE() macro and
+ * passed to this function by the ::SCHEDULER_INIT() macro. With the packed
+ * queue backend, the capacity is limited to ::SCHEDULER_PACKED_LANES: the slots
+ * beyond the lanes are never allocated, thus the jobs added beyond them are
+ * rejected. The ::SCHEDULER_INIT() macro rejects such a storage at compile
+ * time.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param jobs      Pointer to the array of the hot data of the jobs with
+ *                  capacity elements.
+ * @param jobData   Pointer to the array of the cold data of the jobs with
+ *                  capacity elements.
+ * @param bitmaps   Pointer to the array of 5 * SCHEDULER_BITMAP_WORDS(capacity)
+ *                  words for the bitmasks of the scheduler.
+ * @param capacity  The maximum number of jobs of the scheduler.
+ */
+void SchedulerInit(Scheduler_t* const sched,
+                   Job_t* const jobs,
+                   JobData_t* const jobData,
+                   uint32_t* const bitmaps,
+                   const uint16_t capacity)
+{
+    assert_param(jobs != NULL);
+    assert_param(jobData != NULL);
+    assert_param(bitmaps != NULL);
+    assert_param((capacity > 0U) && (capacity <= SCHEDULER_MAX_CAPACITY));
+
+#if(SCHEDULER_QUEUE == SCHEDULER_QUEUE_PACKED)
+    sched->capacity = (capacity < SCHEDULER_PACKED_LANES)
+                          ? capacity
+                          : (uint16_t)SCHEDULER_PACKED_LANES;
+#else
+    sched->capacity = capacity;
+#endif
+
+    sched->referenceTime = 0U;
+    sched->isRunning     = 0U;
+    sched->runRequest    = RUN_REQUEST_NONE;
+    sched->jobs          = jobs;
+    sched->jobData       = jobData;
+    sched->allocated     = bitmaps;
+    sched->requests      = &bitmaps[SCHEDULER_BITMAP_WORDS(capacity)];
+    sched->ready         = &bitmaps[2U * SCHEDULER_BITMAP_WORDS(capacity)];
+    sched->notify        = &bitmaps[3U * SCHEDULER_BITMAP_WORDS(capacity)];
+    sched->deferrable    = &bitmaps[4U * SCHEDULER_BITMAP_WORDS(capacity)];
+    sched->next          = NULL;
+
+    sched->stats.wakeups              = 0U;
+    sched->stats.nominalWakeups       = 0U;
+    sched->stats.lastNominalTime      = 0U;
+    sched->stats.missedActivations    = 0U;
+    sched->stats.skippedExecutions    = 0U;
+    sched->stats.overruns             = 0U;
+    sched->stats.deferredExecutions   = 0U;
+    sched->stats.coalescedJobs        = 0U;
+    sched->stats.stretchedActivations = 0U;
+    sched->stats.stretchedTime        = 0U;
+    sched->stats.scratchFailures      = 0U;
+    sched->stats.governorLevel        = 0U;
+    sched->stats.scratchHighWater     = 0U;
+
+    sched->harmonicBase        = 0U;
+    sched->harmonicTolerance   = 0U;
+    sched->currentJob          = SCHEDULER_INVALID_HANDLE;
+    sched->executionBudget     = 0U;
+    sched->scratch             = NULL;
+    sched->scratchSize         = 0U;
+    sched->scratchUsed         = 0U;
+    sched->wakeupBudget        = 0U;
+    sched->governorWakeups     = 0U;
+    sched->governorWindowStart = 0U;
+    sched->governorHeadroom    = 0U;
+    sched->table               = NULL;
+    sched->tableCycleStart     = 0U;
+    sched->tablePosition       = 0U;
+    sched->tableJobs           = 0U;
+    sched->tableNotify         = 0U;
+    sched->tablePending        = 0U;
+
+    for(uint_fast16_t i = 0U; i < SCHEDULER_BITMAP_WORDS(sched->capacity); ++i)
+    {
+        sched->allocated[i]  = 0U;
+        sched->requests[i]   = 0U;
+        sched->ready[i]      = 0U;
+        sched->notify[i]     = 0U;
+        sched->deferrable[i] = 0U;
+    }
+
+    for(uint_fast16_t i = 0U; i < sched->capacity; ++i)
+    {
+        sched->jobs[i].request      = REQUEST_NONE;
+        sched->jobs[i].generation   = 1U;
+        sched->jobs[i].slack        = 0U;
+        sched->jobs[i].isActive     = 0U;
+        sched->jobs[i].isPaused     = 0U;
+        sched->jobs[i].pending      = 0U;
+        sched->jobs[i].priority     = SCHEDULER_PRIORITY_NORMAL;
+        sched->jobs[i].stretchLimit = 1U;
+        sched->jobs[i].type         = SCHEDULER_JOB_PERIODIC;
+
+        sched->jobData[i].phaseError     = 0U;
+        sched->jobData[i].requestedSlack = 0U;
+        sched->jobData[i].predecessor    = SCHEDULER_NO_JOB;
+        sched->jobData[i].firstSuccessor = SCHEDULER_NO_JOB;
+        sched->jobData[i].nextSibling    = SCHEDULER_NO_JOB;
+        sched->jobData[i].wcet           = 0U;
+        sched->jobData[i].policy         = SCHEDULER_POLICY_RUN_ONCE;
+        sched->jobData[i].catchUpLimit   = 0U;
+        sched->jobData[i].requestedPolicy =
+            POLICY_MAKE(SCHEDULER_POLICY_RUN_ONCE, 0U);
+        sched->jobData[i].requestedPriority     = SCHEDULER_PRIORITY_NORMAL;
+        sched->jobData[i].requestedStretchLimit = 1U;
+    }
+}
+
+/**
+ * @brief  Add a new job to the scheduler.
+ *
+ * The job is added to the scheduler at the next processing step. If the
+ * scheduler is running, the processing is triggered immediately by setting the
+ * RTC alarm interrupt pending.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param period    The period in [s] which the job needs to be executed, up to
+ *                  ::SCHEDULER_MAX_PERIOD.
+ * @param callback  The callback function that is called upon job execution.
+ * @param context   The context passed to the callback function.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAddJob(Scheduler_t* const sched,
+                            const uint32_t period,
+                            const Callback_t callback,
+                            void* const context)
+{
+    assert_param(period > 0U);
+
+    const uint32_t snappedPeriod = Scheduler_SnapPeriod(sched, period);
+
+    return Scheduler_AddJob(sched,
+                            SCHEDULER_JOB_PERIODIC,
+                            snappedPeriod,
+                            snappedPeriod,
+                            SCHEDULER_WEEKDAYS_ALL,
+                            SCHEDULER_NO_JOB,
+                            callback,
+                            context);
+}
+
+/**
+ * @brief  Add a new periodic job to the scheduler whose first execution is
+ *         delayed.
+ *
+ * The first execution of the job is due the given delay after the job has been
+ * added, then the job is executed periodically. The later deadlines are
+ * anchored to the first deadline.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param delay     The delay in [s] of the first execution of the job.
+ * @param period    The period in [s] which the job needs to be executed, up to
+ *                  ::SCHEDULER_MAX_PERIOD.
+ * @param callback  The callback function that is called upon job execution.
+ * @param context   The context passed to the callback function.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAddDelayedJob(Scheduler_t* const sched,
+                                   const uint32_t delay,
+                                   const uint32_t period,
+                                   const Callback_t callback,
+                                   void* const context)
+{
+    assert_param(period > 0U);
+
+    return Scheduler_AddJob(sched,
+                            SCHEDULER_JOB_PERIODIC,
+                            Scheduler_SnapPeriod(sched, period),
+                            delay,
+                            SCHEDULER_WEEKDAYS_ALL,
+                            SCHEDULER_NO_JOB,
+                            callback,
+                            context);
+}
+
+/**
+ * @brief  Add a new one-shot job to the scheduler.
+ *
+ * The job is executed once, the given delay after the job has been added. The
+ * job is released after its execution, thus its handle becomes invalid, unless
+ * the job has been rescheduled by its callback.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param delay     The delay in [s] of the execution of the job.
+ * @param callback  The callback function that is called upon job execution.
+ * @param context   The context passed to the callback function.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAddOneShotJob(Scheduler_t* const sched,
+                                   const uint32_t delay,
+                                   const Callback_t callback,
+                                   void* const context)
+{
+    return Scheduler_AddJob(sched,
+                            SCHEDULER_JOB_ONE_SHOT,
+                            0U,
+                            delay,
+                            SCHEDULER_WEEKDAYS_ALL,
+                            SCHEDULER_NO_JOB,
+                            callback,
+                            context);
+}
+
+/**
+ * @brief  Add a new deferrable job to the scheduler, e.g. for background work
+ *         without a fixed period such as flushing statistics.
+ *
+ * The job is executed once, upon the next wakeup on which another job is
+ * executed, thus it does not cause a wakeup of its own. Only if no other job
+ * is executed within the maximum latency after the job has been added, the
+ * RTC alarm is configured for the end of the latency. The job is released
+ * after its execution, thus its handle becomes invalid, unless the job has
+ * been rescheduled by its callback.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched       Pointer to the scheduler.
+ * @param maxLatency  The maximum latency in [s] of the execution of the job.
+ * @param callback    The callback function that is called upon job execution.
+ * @param context     The context passed to the callback function.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAddDeferrableJob(Scheduler_t* const sched,
+                                      const uint32_t maxLatency,
+                                      const Callback_t callback,
+                                      void* const context)
+{
+    return Scheduler_AddJob(sched,
+                            SCHEDULER_JOB_DEFERRABLE,
+                            0U,
+                            maxLatency,
+                            SCHEDULER_WEEKDAYS_ALL,
+                            SCHEDULER_NO_JOB,
+                            callback,
+                            context);
+}
+
+/**
+ * @brief  Add a new calendar job to the scheduler.
+ *
+ * The job is executed at the times of the day that match the given fields on
+ * the given weekdays, e.g. daily at 07:30:00, every Monday at 09:00:00 or every
+ * hour at :00:00. Similarly to the masks of the RTC alarm, a field with the
+ * value ::SCHEDULER_CALENDAR_ANY matches any value. A field can only be masked
+ * if the more significant fields are masked as well:
+ * - hours, minutes and seconds given: executed daily,
+ * - hours masked: executed hourly at the given minutes and seconds,
+ * - hours and minutes masked: executed every minute at the given seconds.
+ *
+ * The deadlines of the job are calculated from the calendar time of the RTC,
+ * thus the RTC alarm is configured for the exact times of the executions and
+ * the job does not cause any further wakeups. Daily jobs are not supported
+ * with 16-bit periods, see ::SCHEDULER_PERIOD_BITS.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param hours     The hours (0-23) or ::SCHEDULER_CALENDAR_ANY.
+ * @param minutes   The minutes (0-59) or ::SCHEDULER_CALENDAR_ANY.
+ * @param seconds   The seconds (0-59) or ::SCHEDULER_CALENDAR_ANY.
+ * @param weekdays  The weekday mask of the executions, e.g.
+ *                  ::SCHEDULER_WEEKDAYS_WORKDAYS or
+ *                  SCHEDULER_WEEKDAY(RTC_WEEKDAY_MONDAY).
+ * @param callback  The callback function that is called upon job execution.
+ * @param context   The context passed to the callback function.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAddCalendarJob(Scheduler_t* const sched,
+                                    const uint8_t hours,
+                                    const uint8_t minutes,
+                                    const uint8_t seconds,
+                                    const uint8_t weekdays,
+                                    const Callback_t callback,
+                                    void* const context)
+{
+    uint32_t period = 0U;
+    uint32_t offset = 0U;
+
+    assert_param((hours < 24U) || (hours == SCHEDULER_CALENDAR_ANY));
+    assert_param((minutes < 60U) || (minutes == SCHEDULER_CALENDAR_ANY));
+    assert_param((seconds < 60U) || (seconds == SCHEDULER_CALENDAR_ANY));
+    assert_param((hours == SCHEDULER_CALENDAR_ANY) ||
+                 (minutes != SCHEDULER_CALENDAR_ANY));
+    assert_param((minutes == SCHEDULER_CALENDAR_ANY) ||
+                 (seconds != SCHEDULER_CALENDAR_ANY));
+    assert_param((weekdays & SCHEDULER_WEEKDAYS_ALL) != 0U);
+
+    if(hours != SCHEDULER_CALENDAR_ANY)
+    {
+        period = SECONDS_PER_DAY;
+        offset = ((uint32_t)hours * SECONDS_PER_HOUR) +
+                 ((uint32_t)minutes * SECONDS_PER_MINUTE) + seconds;
+    }
+    else if(minutes != SCHEDULER_CALENDAR_ANY)
+    {
+        period = SECONDS_PER_HOUR;
+        offset = ((uint32_t)minutes * SECONDS_PER_MINUTE) + seconds;
+    }
+    else if(seconds != SCHEDULER_CALENDAR_ANY)
+    {
+        period = SECONDS_PER_MINUTE;
+        offset = seconds;
+    }
+    else
+    {
+        period = 1U;
+        offset = 0U;
+    }
+
+    return Scheduler_AddJob(sched,
+                            SCHEDULER_JOB_CALENDAR,
+                            period,
+                            offset,
+                            weekdays,
+                            SCHEDULER_NO_JOB,
+                            callback,
+                            context);
+}
+
+/**
+ * @brief  Add a new triggered job to the scheduler.
+ *
+ * A triggered job has no deadline of its own: it is executed right after each
+ * execution of its predecessor, in the same dispatch pass, followed by its own
+ * triggered jobs. Thus a pipeline of stages, e.g. read, process and store,
+ * needs a single wakeup. A job can have several triggered jobs, which are
+ * executed in the reverse order of adding them. Since the predecessor must
+ * exist when the job is added, the jobs form a tree, thus no cycles can occur.
+ * Cancelling a job also cancels its triggered jobs.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param predecessor  The handle of the job after which the job is executed.
+ *                     The predecessor must have a callback, i.e. it must not
+ *                     be a job that notifies a task.
+ * @param callback     The callback function that is called upon job execution.
+ * @param context      The context passed to the callback function.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAddTriggeredJob(Scheduler_t* const sched,
+                                     const JobHandle_t predecessor,
+                                     const Callback_t callback,
+                                     void* const context)
+{
+    JobHandle_t handle = SCHEDULER_INVALID_HANDLE;
+    uint16_t index     = 0U;
+
+    assert_param(callback != NULL);
+
+    if((Scheduler_GetJob(sched, predecessor, &index) != 0U) &&
+       (sched->jobData[index].callback != NULL))
+    {
+        handle = Scheduler_AddJob(sched,
+                                  SCHEDULER_JOB_TRIGGERED,
+                                  0U,
+                                  0U,
+                                  SCHEDULER_WEEKDAYS_ALL,
+                                  index,
+                                  callback,
+                                  context);
+    }
+    else
+    {
+        handle = SCHEDULER_INVALID_HANDLE;
+    }
+
+    return handle;
+}
+
+/**
+ * @brief  Add a new table job to the scheduler.
+ *
+ * A table job has no deadline of its own: it is made pending by the wakeup
+ * entries of the static schedule of the scheduler, see ::SchedulerSetTable().
+ * Bit i of the pending masks of the schedule refers to the job at index i,
+ * thus the table jobs must be added first, in the order of the job description
+ * that the schedule has been generated from. A job that would be allocated at
+ * an index beyond ::SCHEDULER_TABLE_MAX_JOBS cannot be referred to by the
+ * schedule, thus it is rejected and its slot is released at the next processing
+ * step.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param callback  The callback function that is called upon job execution.
+ * @param context   The context passed to the callback function.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAddTableJob(Scheduler_t* const sched,
+                                 const Callback_t callback,
+                                 void* const context)
+{
+    JobHandle_t handle = Scheduler_AddJob(sched,
+                                          SCHEDULER_JOB_TABLE,
+                                          0U,
+                                          0U,
+                                          SCHEDULER_WEEKDAYS_ALL,
+                                          SCHEDULER_NO_JOB,
+                                          callback,
+                                          context);
+
+    if((handle != SCHEDULER_INVALID_HANDLE) &&
+       ((handle & 0xFFFFU) >= SCHEDULER_TABLE_MAX_JOBS))
+    {
+        /* The job is out of range of the pending masks */
+        (void)SchedulerCancelJob(sched, handle);
+        handle = SCHEDULER_INVALID_HANDLE;
+    }
+    else
+    {
+        /* The job has been added, or no slot is free */
+    }
+
+    return handle;
+}
+
+/**
+ * @brief  Set the active window of a job.
+ *
+ * The job is only executed within its active window, i.e. between the given
+ * minutes of the day on the given weekdays, e.g. from 08:00 to 18:00 on
+ * workdays. The executions that would fall outside of the window are skipped
+ * without waking up the microcontroller: the next deadline of the job is moved
+ * to its first execution within the window, keeping the phase of the job.
+ *
+ * The window is taken over at the next processing step and applied when the
+ * next deadline of the job is calculated, i.e. upon adding, rescheduling or
+ * executing the job. A job is never executed
+ * outside of its window. If the window cannot be hit by the executions of the
+ * job, the job is unscheduled until it is rescheduled.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param handle    The handle of the job.
+ * @param start     The minute of the day when the window opens, e.g.
+ *                  SCHEDULER_TIME_OF_DAY(8U, 0U).
+ * @param end       The minute of the day when the window closes, must be later
+ *                  than the start. ::SCHEDULER_MINUTES_PER_DAY denotes the end
+ *                  of the day.
+ * @param weekdays  The weekday mask of the window.
+ * @return  A non-zero value if the window has been set; otherwise zero, i.e.
+ *          the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerSetJobWindow(Scheduler_t* const sched,
+                              const JobHandle_t handle,
+                              const uint16_t start,
+                              const uint16_t end,
+                              const uint8_t weekdays)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    assert_param(start < end);
+    assert_param(end <= SCHEDULER_MINUTES_PER_DAY);
+    assert_param((weekdays & SCHEDULER_WEEKDAYS_ALL) != 0U);
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        sched->jobData[index].requestedWindow =
+            WINDOW_MAKE(start, end, weekdays);
+        Scheduler_PostSettings(sched, index);
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Cancel a job.
+ *
+ * The job is removed from the scheduler at the next processing step. A pending
+ * execution of the job is discarded.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @return  A non-zero value if the cancellation has been requested; otherwise
+ *          zero, i.e. the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerCancelJob(Scheduler_t* const sched, const JobHandle_t handle)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        result = Scheduler_PostRequest(sched, index, REQUEST_CANCEL);
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Change the period of a job.
+ *
+ * The new period is applied at the next processing step: the next execution of
+ * the job is due one new period after the processing step. A one-shot job or a
+ * calendar job becomes a periodic job.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @param period  The new period in [s] of the job, up to
+ *                ::SCHEDULER_MAX_PERIOD.
+ * @return  A non-zero value if the change has been requested; otherwise zero,
+ *          i.e. the handle is invalid, the job has been cancelled or the period
+ *          is out of range.
+ */
+uint8_t SchedulerRescheduleJob(Scheduler_t* const sched,
+                               const JobHandle_t handle,
+                               const uint32_t period)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    assert_param(period > 0U);
+
+    const uint32_t snappedPeriod = Scheduler_SnapPeriod(sched, period);
+
+    if((snappedPeriod <= SCHEDULER_MAX_PERIOD) &&
+       (Scheduler_GetJob(sched, handle, &index) != 0U))
+    {
+        sched->jobData[index].requestedPeriod =
+            (SchedulerPeriod_t)snappedPeriod;
+        result = Scheduler_PostRequest(sched, index, REQUEST_RESCHEDULE);
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Lengthen the period of a periodic job, e.g. when its callback has
+ *         found nothing to do.
+ *
+ * With the ::SCHEDULER_BACKOFF_LINEAR mode, the base period of the job is added
+ * to the period, with the ::SCHEDULER_BACKOFF_EXPONENTIAL mode the period is
+ * doubled, up to the given maximum period. The new period is applied at the
+ * next processing step, keeping the phase of the job: the next execution is due
+ * one new period after the latest activation of the job. The RTC alarm is only
+ * re-programmed if the earliest deadline changes.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs, e.g. with the handle returned by
+ *        ::SchedulerGetCurrentJob().
+ *
+ * @param sched      Pointer to the scheduler.
+ * @param handle     The handle of the job.
+ * @param mode       The backoff mode.
+ * @param maxPeriod  The maximum period in [s] of the job.
+ * @return  A non-zero value if the change has been requested or the period has
+ *          already reached the maximum; otherwise zero, i.e. the handle is
+ *          invalid, the job has been cancelled or it is not a periodic job.
+ */
+uint8_t SchedulerBackOffJob(Scheduler_t* const sched,
+                            const JobHandle_t handle,
+                            const uint8_t mode,
+                            const uint32_t maxPeriod)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    assert_param(mode <= SCHEDULER_BACKOFF_EXPONENTIAL);
+
+    if((Scheduler_GetJob(sched, handle, &index) != 0U) &&
+       (sched->jobs[index].type == SCHEDULER_JOB_PERIODIC))
+    {
+        JobData_t* const data = &sched->jobData[index];
+        const uint32_t limit  = (maxPeriod < SCHEDULER_MAX_PERIOD)
+                                    ? maxPeriod
+                                    : SCHEDULER_MAX_PERIOD;
+        uint32_t period       = data->requestedPeriod;
+
+        if(mode == SCHEDULER_BACKOFF_LINEAR)
+        {
+            period += data->basePeriod;
+        }
+        else
+        {
+            period *= 2U;
+        }
+
+        if(period > limit)
+        {
+            period = limit;
+        }
+
+        result = 1U;
+        if(period != data->requestedPeriod)
+        {
+            data->requestedPeriod = (SchedulerPeriod_t)period;
+            result = Scheduler_PostRequest(sched, index, REQUEST_ADAPT);
+        }
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Reset the period of a periodic job to its base period, e.g. when its
+ *         callback has detected activity after a backoff.
+ *
+ * The base period is the period that the job has been added or rescheduled
+ * with. The period is applied at the next processing step, keeping the phase of
+ * the job: the next execution is due at the first multiple of the base period
+ * after the latest activation of the job that has not passed yet.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @return  A non-zero value if the change has been requested or the job already
+ *          has its base period; otherwise zero, i.e. the handle is invalid, the
+ *          job has been cancelled or it is not a periodic job.
+ */
+uint8_t SchedulerResetJobPeriod(Scheduler_t* const sched,
+                                const JobHandle_t handle)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if((Scheduler_GetJob(sched, handle, &index) != 0U) &&
+       (sched->jobs[index].type == SCHEDULER_JOB_PERIODIC))
+    {
+        JobData_t* const data = &sched->jobData[index];
+
+        result = 1U;
+        if(data->requestedPeriod != data->basePeriod)
+        {
+            data->requestedPeriod = data->basePeriod;
+            result = Scheduler_PostRequest(sched, index, REQUEST_ADAPT);
+        }
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Pause a job.
+ *
+ * The job is removed from the queue at the next processing step and its
+ * pending executions are dropped, thus it does not cause wakeups until it is
+ * resumed. A paused triggered job is not executed after its predecessor, nor
+ * are its own triggered jobs. The other jobs are not affected.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @return  A non-zero value if the pause has been requested; otherwise zero,
+ *          i.e. the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerPauseJob(Scheduler_t* const sched, const JobHandle_t handle)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        result = Scheduler_PostRequest(sched, index, REQUEST_PAUSE);
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Resume a paused job.
+ *
+ * The job is re-inserted into the queue at the next processing step, keeping
+ * its phase: the next execution is due at its first nominal deadline that has
+ * not passed yet, thus the activations missed while the job was paused are not
+ * caught up with. A one-shot job whose time has passed meanwhile becomes due
+ * at the processing step. A job that has been paused before its addition has
+ * been applied is scheduled first, thus it is resumed on the grid of its
+ * addition.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @return  A non-zero value if the resumption has been requested; otherwise
+ *          zero, i.e. the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerResumeJob(Scheduler_t* const sched, const JobHandle_t handle)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        result = Scheduler_PostRequest(sched, index, REQUEST_RESUME);
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Execute a job immediately, e.g. upon a button press, without waiting
+ *         for its next deadline.
+ *
+ * The job becomes ready at the next processing step, which is triggered
+ * immediately if the scheduler is running, and it is executed according to its
+ * priority together with its triggered jobs. A paused job is executed too, but
+ * it stays paused. By default, the schedule of the job is not changed. If the
+ * phase is reset, the next execution of a periodic job is due one period after
+ * the processing step and its later deadlines are anchored to that time. A
+ * one-shot job is released after its execution.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs. While the scheduler is stopped,
+ *        the job is executed after the scheduler is started.
+ *
+ * @param sched       Pointer to the scheduler.
+ * @param handle      The handle of the job.
+ * @param resetPhase  Non-zero to restart the period of a periodic job.
+ * @return  A non-zero value if the execution has been requested; otherwise
+ *          zero, i.e. the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerTriggerJob(Scheduler_t* const sched,
+                            const JobHandle_t handle,
+                            const uint8_t resetPhase)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        const uint32_t type =
+            (resetPhase != 0U) ? REQUEST_RESTART : REQUEST_TRIGGER;
+        result = Scheduler_PostRequest(sched, index, type);
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Set the time of the next execution of a periodic job explicitly.
+ *
+ * The deadline is applied at the next processing step and the later deadlines
+ * of the job are anchored to it, i.e. they follow at whole periods. A deadline
+ * that has already passed makes the job due at the processing step.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param handle    The handle of the job.
+ * @param deadline  The time (Unix epoch) of the next execution of the job.
+ * @return  A non-zero value if the change has been requested; otherwise zero,
+ *          i.e. the handle is invalid, the job has been cancelled or it is not
+ *          a periodic job.
+ */
+uint8_t SchedulerSetJobNextDeadline(Scheduler_t* const sched,
+                                    const JobHandle_t handle,
+                                    const uint32_t deadline)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if((Scheduler_GetJob(sched, handle, &index) != 0U) &&
+       (sched->jobs[index].type == SCHEDULER_JOB_PERIODIC))
+    {
+        sched->jobData[index].requestedDeadline = deadline;
+        result = Scheduler_PostRequest(sched, index, REQUEST_DEADLINE);
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Get the handle of the job whose callback is being executed.
+ *
+ * The function allows a callback to change its own job, e.g. to back off,
+ * without storing the handle of the job in its context.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @return  The handle of the job if called from a callback executed by
+ *          ::SchedulerExecutePendingJobs(); otherwise
+ *          ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerGetCurrentJob(const Scheduler_t* const sched)
+{
+    return sched->currentJob;
+}
+
+/**
+ * @brief  Set the slack of a job.
+ *
+ * The slack allows the job to be executed up to the given amount of time later
+ * than its nominal time. Upon each wakeup, the jobs whose execution window has
+ * already opened are executed together with the due jobs, thus jobs with
+ * nearby deadlines share a single wakeup. The RTC alarm is configured for the
+ * end of the earliest execution window, which is the latest alarm time that
+ * satisfies every job, thus it also satisfies the most jobs inside their
+ * windows.
+ *
+ * The slack is applied when the next deadline of the job is calculated, i.e.
+ * upon adding, rescheduling or executing the job.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @param slack   The slack in [s] of the job.
+ * @return  A non-zero value if the slack has been set; otherwise zero, i.e. the
+ *          handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerSetJobSlack(Scheduler_t* const sched,
+                             const JobHandle_t handle,
+                             const uint16_t slack)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        sched->jobData[index].requestedSlack = slack;
+        result                               = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Process a scheduler instance.
+ *
+ * This function needs to be called each time upon an RTC alarm interrupt. The
+ * function applies the start and stop requests and the requests of the job API
+ * functions, then sets the pending flags of the jobs that are due and returns
+ * the deadline of the job that needs to be executed the earliest.
+ *
+ * Only the jobs that are due are touched: each of them is removed from the
+ * queue and re-inserted with its next deadline. With the heap backend this
+ * costs O(k log n) for k due jobs out of n jobs and the next deadline is read
+ * from the root of the heap in O(1). With the timing wheel backend, insertion
+ * is O(1) and the wheel is cascaded lazily upon each wakeup.
+ *
+ * @note  The function does not configure the RTC alarm, since the alarm is
+ *        shared by all scheduler instances. The RTC alarm is configured by the
+ *        ::SchedulerMuxProcess() function for the earliest deadline of all
+ *        instances that are attached to the multiplexer.
+ *
+ * @note  The function does not automatically execute the callbacks of the
+ *        pending jobs to provide more flexibility for the application.
+ *        The pending jobs can be executed by calling the
+ *        ::SchedulerExecutePendingJobs() function.
+ *
+ * @param sched         Pointer to the scheduler.
+ * @param currentTime   The current time (Unix epoch).
+ * @param nextDeadline  Pointer where the earliest deadline is written.
+ * @return  A non-zero value if the scheduler is running and has a job to be
+ *          scheduled; otherwise zero.
+ */
+uint8_t SchedulerProcess(Scheduler_t* const sched,
+                         const uint32_t currentTime,
+                         uint32_t* const nextDeadline)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    const uint32_t runRequest =
+        AtomicExchange(&sched->runRequest, RUN_REQUEST_NONE);
+    if((runRequest == RUN_REQUEST_START) && (sched->isRunning == 0U))
+    {
+        Scheduler_Start(sched, currentTime);
+    }
+    else if((runRequest == RUN_REQUEST_STOP) && (sched->isRunning != 0U))
+    {
+        Scheduler_Stop(sched, currentTime);
+    }
+    else
+    {
+        /* No change of the run state */
+    }
+
+    if(sched->isRunning != 0U)
+    {
+        Scheduler_ApplyRequests(sched, currentTime);
+        Scheduler_ProcessDueJobs(sched, currentTime);
+        result = SchedulerQueuePeek(sched, &index);
+        if(result != 0U)
+        {
+            *nextDeadline = sched->jobs[index].deadline;
+        }
+
+        /* The next wakeup entry of the static schedule */
+        if(sched->table != NULL)
+        {
+            const uint32_t tableDeadline =
+                sched->tableCycleStart +
+                sched->table->entries[sched->tablePosition].offset;
+            if((result == 0U) || (tableDeadline < *nextDeadline))
+            {
+                *nextDeadline = tableDeadline;
+                result        = 1U;
+            }
+        }
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Execute the pending jobs.
+ *
+ * The jobs that are ready for execution are taken from the ready bitmask of
+ * the scheduler in the order of their priority classes, and within a class in
+ * the order of their deadlines (earliest deadline first), where the deadline of
+ * a ready job is its next deadline. The callback of each job is executed once
+ * for each pending execution. Each job is selected by walking the set bits of
+ * the bitmask with a count-trailing-zeros instruction, thus only the words of
+ * the bitmask and the ready jobs are read, not the slots of the idle jobs.
+ *
+ * The bits of the ready jobs are set by the processing function of the
+ * scheduler and cleared by this function without locking, thus the callbacks
+ * can be executed in a different context than the processing, e.g. in a
+ * dispatcher task that is notified by the RTC alarm interrupt handler.
+ *
+ * If an execution budget is set, the jobs that are not in the
+ * ::SCHEDULER_PRIORITY_CRITICAL class are left ready once the budget has been
+ * used up, thus they are executed upon the next wakeup.
+ *
+ * @note  The processing function of the scheduler does not automatically
+ *        execute the callbacks of the pending jobs. Therefore, this function
+ *        must be called after calling the processing function of the scheduler.
+ *
+ * @warning  Depending on the implementation, this function may be called from
+ *           an interrupt context, or a task context, but only from a single
+ *           context that does not preempt the processing of the scheduler.
+ *           Consequently, the callback functions of the jobs are executed from
+ *           the same context. This must be taken into account, i.e. care must
+ *           be taken upon writing the callbacks of the jobs. For instance,
+ *           calling this function from an ISR means that the jobs are also
+ *           executed within the context of the ISR, thus the callbacks must not
+ *           block and they can only call interrupt-safe RTOS API functions.
+ *
+ * @param sched  Pointer to the scheduler.
+ */
+void SchedulerExecutePendingJobs(Scheduler_t* const sched)
+{
+    const uint32_t startTime = HAL_GetTick();
+    uint16_t index           = Scheduler_SelectReadyJob(sched);
+
+    while(index != SCHEDULER_NO_JOB)
+    {
+        Job_t* const job            = &sched->jobs[index];
+        const JobData_t* const data = &sched->jobData[index];
+
+        /* Defer the remaining jobs to the next wakeup if the budget has been
+         * used up. The selected job has the highest priority of the ready
+         * jobs, thus the remaining jobs are not critical either. */
+        if((sched->executionBudget != 0U) &&
+           (job->priority != SCHEDULER_PRIORITY_CRITICAL) &&
+           ((HAL_GetTick() - startTime) >= sched->executionBudget))
+        {
+            sched->stats.deferredExecutions += Scheduler_CountReadyJobs(sched);
+            break;
+        }
+
+        /* Take over the pending executions, including the one recorded by the
+         * static schedule. If the job becomes due again meanwhile, it is
+         * marked as ready again. A job without a callback can only be found
+         * here if its slot has been reused since it was marked; its pending
+         * executions are left for the notification. */
+        AtomicFetchAnd(&sched->ready[index / 32U], ~(1UL << (index % 32U)));
+        uint8_t pending = 0U;
+        if(data->callback != NULL)
+        {
+            pending = AtomicExchangeByte(&job->pending, 0U);
+            pending += Scheduler_TakeTableExecution(sched, index);
+        }
+        const uint8_t isReady = (pending != 0U) ? 1U : 0U;
+
+        while(pending != 0U)
+        {
+            /* Execute job callback */
+            sched->currentJob = HANDLE_MAKE(index, job->generation);
+            data->callback(data->context);
+
+            /* Execute the triggered jobs in the same pass */
+            Scheduler_ExecuteSuccessors(sched, index);
+
+            /* Decrement the number of pending executions */
+            --pending;
+        }
+        sched->currentJob = SCHEDULER_INVALID_HANDLE;
+
+        /* Release an executed one-shot or deferrable job, unless its callback
+         * has requested a change of the job */
+        if((isReady != 0U) && ((job->type == SCHEDULER_JOB_ONE_SHOT) ||
+                               (job->type == SCHEDULER_JOB_DEFERRABLE)))
+        {
+            Scheduler_PostRelease(sched, index);
+        }
+
+        index = Scheduler_SelectReadyJob(sched);
+    }
+
+    /* Release the blocks allocated by the callbacks of this pass */
+    sched->scratchUsed = 0U;
+}
+
+/**
+ * @brief  Check whether a scheduler has jobs that are ready for execution.
+ *
+ * The function can be used by the RTC alarm interrupt handler to decide whether
+ * the context that executes the pending jobs needs to be notified.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @return  A non-zero value if jobs are ready for execution; otherwise zero.
+ */
+uint8_t SchedulerHasPendingJobs(const Scheduler_t* const sched)
+{
+    uint8_t result = 0U;
+
+    for(uint_fast16_t i = 0U;
+        (i < SCHEDULER_BITMAP_WORDS(sched->capacity)) && (result == 0U);
+        ++i)
+    {
+        result = (sched->ready[i] != 0U) ? 1U : 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Take the next notification of the jobs that have no callback.
+ *
+ * A job that is added without a callback is not marked as ready.
+ * Instead, its context is returned by this function together with the number of
+ * its pending executions, thus the caller can forward the executions directly,
+ * e.g. by notifying the RTOS task given as the context. The function is meant
+ * to be called repeatedly after the processing of the scheduler, until it
+ * returns zero.
+ *
+ * @note  This function must be called from the same context as the processing
+ *        function of the scheduler, or from a context that does not preempt it.
+ *
+ * @param sched    Pointer to the scheduler.
+ * @param context  Pointer where the context of the job is written.
+ * @param count    Pointer where the number of pending executions is written.
+ * @return  A non-zero value if a notification has been taken; otherwise zero.
+ */
+uint8_t SchedulerTakeNotification(Scheduler_t* const sched,
+                                  void** const context,
+                                  uint8_t* const count)
+{
+    uint8_t result = 0U;
+
+    assert_param(context != NULL);
+    assert_param(count != NULL);
+
+    for(uint_fast16_t i = 0U;
+        (i < SCHEDULER_BITMAP_WORDS(sched->capacity)) && (result == 0U);
+        ++i)
+    {
+        while((sched->notify[i] != 0U) && (result == 0U))
+        {
+            const uint_fast8_t bit = Scheduler_FindFirstSet(sched->notify[i]);
+            const uint16_t index   = (uint16_t)((i * 32U) + bit);
+            Job_t* const job       = &sched->jobs[index];
+
+            AtomicFetchAnd(&sched->notify[i], ~(1UL << bit));
+            *count = AtomicExchangeByte(&job->pending, 0U);
+            *count += Scheduler_TakeTableExecution(sched, index);
+
+            if(*count != 0U)
+            {
+                *context = sched->jobData[index].context;
+                result   = 1U;
+
+                /* Release a notified one-shot or deferrable job, unless a
+                 * change of the job has been requested */
+                if((job->type == SCHEDULER_JOB_ONE_SHOT) ||
+                   (job->type == SCHEDULER_JOB_DEFERRABLE))
+                {
+                    Scheduler_PostRelease(sched, index);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Start a scheduler instance.
+ *
+ * The scheduler is started at the next processing step, which is triggered
+ * immediately by setting the RTC alarm interrupt pending. The deadlines of the
+ * jobs are shifted by the time elapsed since the scheduler was stopped.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers.
+ *
+ * @param sched  Pointer to the scheduler.
+ */
+void SchedulerStart(Scheduler_t* const sched)
+{
+    AtomicExchange(&sched->runRequest, RUN_REQUEST_START);
+    RtcTriggerAlarmInterrupt();
+}
+
+/**
+ * @brief  Stop a scheduler instance.
+ *
+ * The scheduler is stopped at the next processing step, which is triggered
+ * immediately by setting the RTC alarm interrupt pending. Upon stopping, the
+ * jobs are processed and the RTC alarm is re-configured for the remaining
+ * scheduler instances, or deactivated if no instance is running.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers.
+ *
+ * @param sched  Pointer to the scheduler.
+ */
+void SchedulerStop(Scheduler_t* const sched)
+{
+    AtomicExchange(&sched->runRequest, RUN_REQUEST_STOP);
+    RtcTriggerAlarmInterrupt();
+}
+
+/**
+ * @brief  Set the missed-deadline policy of a job.
+ *
+ * The policy determines how the job is executed if one or more of its
+ * activations have been missed, e.g. the microcontroller stayed awake during a
+ * long callback or with a debugger attached:
+ * - ::SCHEDULER_POLICY_RUN_ONCE (default): the job is executed once.
+ * - ::SCHEDULER_POLICY_SKIP: the execution is skipped and the job resumes at
+ *   its next deadline.
+ * - ::SCHEDULER_POLICY_CATCH_UP: the job is executed once for each missed
+ *   activation, up to the catch-up limit.
+ *
+ * The policy is applied at the next processing step.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched         Pointer to the scheduler.
+ * @param handle        The handle of the job.
+ * @param policy        The missed-deadline policy of the job.
+ * @param catchUpLimit  The maximum number of missed activations that are caught
+ *                      up with the ::SCHEDULER_POLICY_CATCH_UP policy.
+ * @return  A non-zero value if the policy has been set; otherwise zero, i.e.
+ *          the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerSetJobPolicy(Scheduler_t* const sched,
+                              const JobHandle_t handle,
+                              const uint8_t policy,
+                              const uint8_t catchUpLimit)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    assert_param(policy <= SCHEDULER_POLICY_CATCH_UP);
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        sched->jobData[index].requestedPolicy =
+            POLICY_MAKE(policy, catchUpLimit);
+        Scheduler_PostSettings(sched, index);
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Get the statistics of a scheduler.
+ *
+ * The statistics contain the wakeup counters and the overload counters, i.e.
+ * the number of missed activations, skipped executions, overruns and deferred
+ * executions.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param stats  Pointer where the statistics are written.
+ */
+void SchedulerGetStats(const Scheduler_t* const sched,
+                       SchedulerStats_t* const stats)
+{
+    *stats = sched->stats;
+}
+
+/**
+ * @brief  Get the number of wakeups saved by the slack of the jobs.
+ *
+ * The number is the difference between the number of wakeups that the executed
+ * jobs would have needed at their nominal times and the number of wakeups that
+ * actually happened. The nominal wakeups are counted conservatively, thus the
+ * result never overstates the savings.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @return  The number of saved wakeups.
+ */
+uint32_t SchedulerGetSavedWakeups(const Scheduler_t* const sched)
+{
+    uint32_t result = 0U;
+
+    if(sched->stats.nominalWakeups > sched->stats.wakeups)
+    {
+        result = sched->stats.nominalWakeups - sched->stats.wakeups;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Get the phase error of a job.
+ *
+ * The phase error is the lateness of the latest execution of the job with
+ * respect to its anchored deadline, i.e. its first deadline plus a whole number
+ * of periods. Since the deadlines are anchored, the phase error does not
+ * accumulate over the executions: it stays within the wakeup latency and the
+ * slack of the job.
+ *
+ * @param sched       Pointer to the scheduler.
+ * @param handle      The handle of the job.
+ * @param phaseError  Pointer where the phase error in [s] is written.
+ * @return  A non-zero value if the phase error has been retrieved; otherwise
+ *          zero, i.e. the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerGetJobPhaseError(const Scheduler_t* const sched,
+                                  const JobHandle_t handle,
+                                  uint32_t* const phaseError)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        *phaseError = sched->jobData[index].phaseError;
+        result      = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Configure the harmonic registration mode of a scheduler.
+ *
+ * In the harmonic registration mode, the periods of the jobs are snapped to the
+ * nearest multiple of the base period if the difference is within the given
+ * tolerance. The first deadline of each job whose period is a multiple of the
+ * base period is aligned to a multiple of its period, thus the jobs share their
+ * wakeups and the hyperperiod of the jobs stays short. The periods of the other
+ * jobs are kept unchanged.
+ *
+ * @note  The mode applies to the jobs that are added or rescheduled after
+ *        calling this function. A base period of zero disables the mode.
+ *
+ * @param sched       Pointer to the scheduler.
+ * @param basePeriod  The base period in [s].
+ * @param tolerance   The tolerance in [%] of the period of a job within which
+ *                    the period is snapped to a multiple of the base period.
+ */
+void SchedulerSetHarmonicMode(Scheduler_t* const sched,
+                              const uint32_t basePeriod,
+                              const uint8_t tolerance)
+{
+    sched->harmonicBase      = basePeriod;
+    sched->harmonicTolerance = tolerance;
+}
+
+/**
+ * @brief  Configure the table-driven mode of a scheduler.
+ *
+ * In the table-driven mode, the table jobs are made pending by a static
+ * schedule that has been generated offline from a fixed job set, e.g. by the
+ * python/generate_schedule.py script. Upon each wakeup, the scheduler steps to
+ * the next wakeup entry of the schedule in O(1) and makes the jobs of its
+ * pending mask ready, without searching the queue and without calculating the
+ * deadlines of the jobs. The schedule starts when the scheduler is started and
+ * repeats itself after its hyperperiod. The other jobs are scheduled by the
+ * queue as usual.
+ *
+ * @note  This function must be called while the scheduler is stopped. A NULL
+ *        schedule disables the mode.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param table  Pointer to the static schedule.
+ */
+void SchedulerSetTable(Scheduler_t* const sched,
+                       const SchedulerTable_t* const table)
+{
+    assert_param(sched->isRunning == 0U);
+    assert_param((table == NULL) ||
+                 ((table->count > 0U) && (table->entries[0U].offset > 0U) &&
+                  (table->entries[table->count - 1U].offset <=
+                   table->hyperperiod)));
+
+    sched->table           = table;
+    sched->tableCycleStart = sched->referenceTime;
+    sched->tablePosition   = 0U;
+}
+
+/**
+ * @brief  Set the priority class of a job.
+ *
+ * The pending jobs are executed in the order of their priority classes, and
+ * within a class in the order of their deadlines. The jobs without a callback
+ * are not affected, since their tasks are notified directly upon processing.
+ * The priority is applied at the next processing step.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param handle    The handle of the job.
+ * @param priority  The priority class of the job, from
+ *                  ::SCHEDULER_PRIORITY_CRITICAL (highest) to
+ *                  ::SCHEDULER_PRIORITY_LOW (lowest).
+ * @return  A non-zero value if the priority has been set; otherwise zero, i.e.
+ *          the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerSetJobPriority(Scheduler_t* const sched,
+                                const JobHandle_t handle,
+                                const uint8_t priority)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    assert_param(priority <= SCHEDULER_PRIORITY_LOW);
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        sched->jobData[index].requestedPriority = priority;
+        Scheduler_PostSettings(sched, index);
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Set the execution budget of the pending jobs per wakeup.
+ *
+ * Once the callbacks executed by ::SchedulerExecutePendingJobs() have used up
+ * the budget, the remaining ready jobs are deferred to the next wakeup, except
+ * for the jobs of the ::SCHEDULER_PRIORITY_CRITICAL class. This way a burst of
+ * low-priority jobs does not keep the microcontroller awake at full clock
+ * speed. The budget is measured by the HAL tick, thus it has a resolution of
+ * one millisecond.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param budget  The execution budget in [ms], or zero to disable the budget.
+ */
+void SchedulerSetExecutionBudget(Scheduler_t* const sched,
+                                 const uint32_t budget)
+{
+    sched->executionBudget = budget;
+}
+
+/**
+ * @brief  Set the maximum number of wakeups per hour of the wakeup governor.
+ *
+ * The governor counts the wakeups of the scheduler. Whenever the count exceeds
+ * the budget within an hour, the stretch level of the governor is raised and
+ * the count is restarted. If at most half of the budget has been used in an
+ * hour, the level is lowered again. At each level, the periods of the jobs of
+ * one more priority class are doubled, starting with the
+ * ::SCHEDULER_PRIORITY_LOW class, up to the stretch limit of each job, see
+ * ::SchedulerSetJobStretchLimit(). The jobs of the
+ * ::SCHEDULER_PRIORITY_CRITICAL class are never stretched. The deadlines stay
+ * on the grid of the original periods, thus the phases of the jobs are kept
+ * when the periods are restored. A changed level is applied to each job when
+ * its next deadline is calculated.
+ *
+ * @param sched           Pointer to the scheduler.
+ * @param wakeupsPerHour  The maximum number of wakeups per hour, or zero to
+ *                        disable the governor.
+ */
+void SchedulerSetWakeupBudget(Scheduler_t* const sched,
+                              const uint16_t wakeupsPerHour)
+{
+    sched->wakeupBudget = wakeupsPerHour;
+}
+
+/**
+ * @brief  Set the maximum factor by which the wakeup governor may stretch the
+ *         period of a periodic job.
+ *
+ * The limit is applied at the next processing step.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @param limit   The maximum factor of the period, where 1 means that the job
+ *                is never stretched, which is the default.
+ * @return  A non-zero value if the limit has been set; otherwise zero, i.e. the
+ *          handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerSetJobStretchLimit(Scheduler_t* const sched,
+                                    const JobHandle_t handle,
+                                    const uint8_t limit)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    assert_param(limit > 0U);
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        sched->jobData[index].requestedStretchLimit = limit;
+        Scheduler_PostSettings(sched, index);
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Declare the worst-case execution time of the callback of a job.
+ *
+ * The execution time is only used by the schedulability analysis, see
+ * ::SchedulerAnalyze(). The execution time of a triggered job is accounted to
+ * each execution of its predecessor. The execution time is stored directly,
+ * since it is never read by the processing of the scheduler.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @param wcet    The worst-case execution time in [ms].
+ * @return  A non-zero value if the execution time has been set; otherwise zero,
+ *          i.e. the handle is invalid or the job has been cancelled.
+ */
+uint8_t SchedulerSetJobWcet(Scheduler_t* const sched,
+                            const JobHandle_t handle,
+                            const uint16_t wcet)
+{
+    uint8_t result = 0U;
+    uint16_t index = 0U;
+
+    if(Scheduler_GetJob(sched, handle, &index) != 0U)
+    {
+        sched->jobData[index].wcet = wcet;
+        result                     = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Set the scratch arena that the callbacks of the jobs can allocate
+ *         temporary buffers from.
+ *
+ * The arena is a bump-pointer allocator: ::SchedulerScratchAlloc() hands out
+ * consecutive blocks of the arena, and all blocks are released at once in O(1)
+ * at the end of each ::SchedulerExecutePendingJobs() pass. This way the jobs
+ * share one RAM pool that only needs to be as large as the largest demand of a
+ * single wakeup, see the scratchHighWater statistic.
+ *
+ * @note  This function must not be called while the pending jobs are being
+ *        executed.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param arena  Pointer to the arena defined by ::SCHEDULER_SCRATCH_DEFINE(),
+ *               or NULL to remove the arena.
+ * @param size   The size in bytes of the arena.
+ */
+void SchedulerSetScratchArena(Scheduler_t* const sched,
+                              void* const arena,
+                              const uint16_t size)
+{
+    assert_param(((uintptr_t)arena % SCHEDULER_SCRATCH_ALIGNMENT) == 0U);
+    assert_param(sched->currentJob == SCHEDULER_INVALID_HANDLE);
+
+    sched->scratch     = (uint8_t*)arena;
+    sched->scratchSize = (arena != NULL) ? size : 0U;
+    sched->scratchUsed = 0U;
+}
+
+/**
+ * @brief  Allocate a temporary buffer from the scratch arena of the scheduler.
+ *
+ * The buffer is aligned to ::SCHEDULER_SCRATCH_ALIGNMENT and remains valid
+ * until the end of the current ::SchedulerExecutePendingJobs() pass, thus it
+ * can be handed over to the triggered jobs of the same pass. The buffer must
+ * not be freed and must not be used after the callback of the last job of the
+ * pass has returned.
+ *
+ * @note  This function must only be called from the callbacks executed by
+ *        ::SchedulerExecutePendingJobs().
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param size   The size in bytes of the buffer.
+ * @return  Pointer to the buffer, or NULL if the size is zero or the arena is
+ *          exhausted.
+ */
+void* SchedulerScratchAlloc(Scheduler_t* const sched, const uint16_t size)
+{
+    void* buffer         = NULL;
+    const uint32_t used  = sched->scratchUsed;
+    const uint32_t block = ((uint32_t)size + SCHEDULER_SCRATCH_ALIGNMENT - 1U) &
+                           ~(SCHEDULER_SCRATCH_ALIGNMENT - 1U);
+
+    assert_param(sched->currentJob != SCHEDULER_INVALID_HANDLE);
+    assert_param((SCHEDULER_SCRATCH_ALIGNMENT != 0U) &&
+                 ((SCHEDULER_SCRATCH_ALIGNMENT &
+                   (SCHEDULER_SCRATCH_ALIGNMENT - 1U)) == 0U));
+
+    if(size == 0U)
+    {
+        /* Nothing to allocate: no block past the used part is handed out */
+    }
+    else if(block <= (sched->scratchSize - used))
+    {
+        buffer             = &sched->scratch[used];
+        sched->scratchUsed = (uint16_t)(used + block);
+
+        if(sched->scratchUsed > sched->stats.scratchHighWater)
+        {
+            sched->stats.scratchHighWater = sched->scratchUsed;
+        }
+    }
+    else
+    {
+        ++sched->stats.scratchFailures;
+    }
+
+    return buffer;
+}
+
+/**
+ * @brief  This function returns the index of the least significant set bit of
+ *         a word.
+ *
+ * @param word  The word, must not be zero.
+ * @return  The index of the least significant set bit.
+ */
+uint_fast8_t Scheduler_FindFirstSet(const uint32_t word)
+{
+    return __CLZ(__RBIT(word));
+}
+
+/**
+ * @brief  This function allocates a free job slot without locking.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  Pointer where the index of the allocated job is written.
+ * @return  A non-zero value if a job slot has been allocated; otherwise zero.
+ */
+uint8_t Scheduler_AllocateJob(Scheduler_t* const sched, uint16_t* const index)
+{
+    uint8_t result = 0U;
+
+    for(uint_fast16_t i = 0U;
+        (i < SCHEDULER_BITMAP_WORDS(sched->capacity)) && (result == 0U);
+        ++i)
+    {
+        uint32_t allocated = sched->allocated[i];
+
+        while(allocated != 0xFFFFFFFFU)
+        {
+            const uint_fast8_t bit = Scheduler_FindFirstSet(~allocated);
+            if(((i * 32U) + bit) >= sched->capacity)
+            {
+                break;
+            }
+
+            if(AtomicCompareExchange(&sched->allocated[i],
+                                     allocated,
+                                     allocated | (1UL << bit)) != 0U)
+            {
+                *index = (uint16_t)((i * 32U) + bit);
+                result = 1U;
+                break;
+            }
+
+            /* The slots have been modified concurrently: retry */
+            allocated = sched->allocated[i];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief  This function allocates a job slot, initializes the job and posts the
+ *         request to schedule it.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param type         The type of the job.
+ * @param period       The period in [s] of the job, or zero for a one-shot or
+ *                     a triggered job.
+ * @param offset       The delay of the first execution or the calendar offset
+ *                     in [s] of the job.
+ * @param weekdays     The weekday mask of the active window of the job.
+ * @param predecessor  The index of the predecessor of a triggered job, or
+ *                     ::SCHEDULER_NO_JOB.
+ * @param callback     The callback function that is called upon job execution.
+ * @param context      The context passed to the callback function.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t Scheduler_AddJob(Scheduler_t* const sched,
+                             const uint8_t type,
+                             const uint32_t period,
+                             const uint32_t offset,
+                             const uint8_t weekdays,
+                             const uint16_t predecessor,
+                             const Callback_t callback,
+                             void* const context)
+{
+    JobHandle_t handle = SCHEDULER_INVALID_HANDLE;
+    uint16_t index     = 0U;
+
+    assert_param((callback != NULL) || (context != NULL));
+
+    if((period <= SCHEDULER_MAX_PERIOD) &&
+       (Scheduler_AllocateJob(sched, &index) != 0U))
+    {
+        Job_t* const job      = &sched->jobs[index];
+        JobData_t* const data = &sched->jobData[index];
+
+        job->type             = type;
+        job->period           = (SchedulerPeriod_t)period;
+        job->offset           = offset;
+        data->basePeriod      = (SchedulerPeriod_t)period;
+        data->requestedPeriod = (SchedulerPeriod_t)period;
+        data->predecessor     = predecessor;
+        data->wcet            = 0U;
+        data->callback        = callback;
+        data->context         = context;
+
+        /* The settings are applied together with the request */
+        data->requestedWindow =
+            WINDOW_MAKE(0U, SCHEDULER_MINUTES_PER_DAY, weekdays);
+        data->requestedPriority     = SCHEDULER_PRIORITY_NORMAL;
+        data->requestedStretchLimit = 1U;
+        (void)Scheduler_PostRequest(sched, index, REQUEST_ADD);
+
+        handle = HANDLE_MAKE(index, job->generation);
+    }
+    else
+    {
+        handle = SCHEDULER_INVALID_HANDLE;
+    }
+
+    return handle;
+}
+
+/**
+ * @brief  This function validates a job handle and retrieves the index of the
+ *         job.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param handle  The handle of the job.
+ * @param index   Pointer where the index of the job is written.
+ * @return  A non-zero value if the handle refers to an allocated job that is
+ *          not being cancelled; otherwise zero.
+ */
+uint8_t Scheduler_GetJob(const Scheduler_t* const sched,
+                         const JobHandle_t handle,
+                         uint16_t* const index)
+{
+    uint8_t result            = 0U;
+    const uint32_t jobIndex   = handle & 0xFFFFU;
+    const uint16_t generation = (uint16_t)(handle >> 16U);
+
+    if((jobIndex < sched->capacity) &&
+       ((sched->allocated[jobIndex / 32U] & (1UL << (jobIndex % 32U))) !=
+        0U) &&
+       (sched->jobs[jobIndex].generation == generation) &&
+       (sched->jobs[jobIndex].request !=
+        REQUEST_MAKE(REQUEST_CANCEL, generation)))
+    {
+        *index = (uint16_t)jobIndex;
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  This function posts a request for a job without locking and triggers
+ *         the processing of the scheduler if it is running.
+ *
+ * A later request overrides an earlier request of the same job that has not
+ * been applied yet, except for a cancellation: the request is replaced with a
+ * compare-exchange that fails if the job is being cancelled, thus a cancelled
+ * job is never brought back by a concurrent request. If the addition of the job
+ * is replaced, the new request carries ::REQUEST_ADD_PENDING, thus the job is
+ * scheduled before the new request is applied. A cancellation drops the
+ * addition, since the job is released anyway.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ * @param type   The type of the request.
+ * @return  A non-zero value if the request has been posted; otherwise zero,
+ *          i.e. the job is being cancelled.
+ */
+uint8_t Scheduler_PostRequest(Scheduler_t* const sched,
+                              const uint16_t index,
+                              const uint32_t type)
+{
+    Job_t* const job      = &sched->jobs[index];
+    const uint32_t cancel = REQUEST_MAKE(REQUEST_CANCEL, job->generation);
+    uint8_t result        = 0U;
+    uint32_t request      = job->request;
+
+    while((result == 0U) && (request != cancel))
+    {
+        uint32_t desired = REQUEST_MAKE(type, job->generation);
+        if((type != REQUEST_CANCEL) && ((request >> 16U) == job->generation) &&
+           ((REQUEST_TYPE(request) == REQUEST_ADD) ||
+            ((request & REQUEST_ADD_PENDING) != 0U)))
+        {
+            /* Keep the addition of the job */
+            desired |= REQUEST_ADD_PENDING;
+        }
+
+        result  = AtomicCompareExchange(&job->request, request, desired);
+        request = job->request;
+    }
+
+    if(result != 0U)
+    {
+        AtomicFetchOr(&sched->requests[index / 32U], 1UL << (index % 32U));
+
+        if(sched->isRunning != 0U)
+        {
+            RtcTriggerAlarmInterrupt();
+        }
+    }
+    else
+    {
+        /* The job is being cancelled */
+    }
+
+    return result;
+}
+
+/**
+ * @brief  This function posts the release of an executed one-shot or
+ *         deferrable job, unless a change of the job has been requested.
+ *
+ * The cancellation is only posted if the job has no pending request, with a
+ * compare-exchange, thus a request posted concurrently, e.g. by an interrupt
+ * handler, is never overridden.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void Scheduler_PostRelease(Scheduler_t* const sched, const uint16_t index)
+{
+    Job_t* const job = &sched->jobs[index];
+
+    if(AtomicCompareExchange(&job->request,
+                             REQUEST_NONE,
+                             REQUEST_MAKE(REQUEST_CANCEL, job->generation)) !=
+       0U)
+    {
+        Scheduler_PostSettings(sched, index);
+    }
+    else
+    {
+        /* A change of the job has been requested */
+    }
+}
+
+/**
+ * @brief  This function triggers the processing of the scheduler to apply the
+ *         requested settings of a job, without overriding the pending request
+ *         of the job.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void Scheduler_PostSettings(Scheduler_t* const sched, const uint16_t index)
+{
+    AtomicFetchOr(&sched->requests[index / 32U], 1UL << (index % 32U));
+
+    if(sched->isRunning != 0U)
+    {
+        RtcTriggerAlarmInterrupt();
+    }
+}
+
+/**
+ * @brief  This function applies the requests posted by the job API functions.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ */
+void Scheduler_ApplyRequests(Scheduler_t* const sched,
+                             const uint32_t currentTime)
+{
+    /* While the scheduler is stopped, the deadlines are relative to the
+     * reference time and the jobs are inserted into the queue upon start */
+    const uint32_t baseTime =
+        (sched->isRunning != 0U) ? currentTime : sched->referenceTime;
+
+    for(uint_fast16_t i = 0U; i < SCHEDULER_BITMAP_WORDS(sched->capacity); ++i)
+    {
+        uint32_t requests = AtomicExchange(&sched->requests[i], 0U);
+
+        while(requests != 0U)
+        {
+            const uint_fast8_t bit = Scheduler_FindFirstSet(requests);
+            const uint16_t index   = (uint16_t)((i * 32U) + bit);
+            Job_t* const job       = &sched->jobs[index];
+            JobData_t* const data  = &sched->jobData[index];
+            requests &= ~(1UL << bit);
+
+            /* The settings are posted without a request of their own */
+            Scheduler_ApplySettings(sched, index);
+
+            const uint32_t request = AtomicExchange(&job->request, 0U);
+            if((request >> 16U) != job->generation)
+            {
+                /* Request of a released job: ignore */
+                continue;
+            }
+
+            if((job->isActive != 0U) && (job->isPaused == 0U) &&
+               (sched->isRunning != 0U))
+            {
+                SchedulerQueueRemove(sched, index);
+            }
+
+            if((request & REQUEST_ADD_PENDING) != 0U)
+            {
+                /* The addition has been replaced by a later request */
+                Scheduler_ScheduleJob(sched, index, baseTime);
+            }
+
+            switch(REQUEST_TYPE(request))
+            {
+                case REQUEST_RESCHEDULE:
+                    Scheduler_UnlinkJob(sched, index);
+                    job->type        = SCHEDULER_JOB_PERIODIC;
+                    job->period      = data->requestedPeriod;
+                    job->offset      = data->requestedPeriod;
+                    data->basePeriod = data->requestedPeriod;
+                    /* Schedule the job with the new period */
+                    Scheduler_ScheduleJob(sched, index, baseTime);
+                    break;
+
+                case REQUEST_ADD:
+                    Scheduler_ScheduleJob(sched, index, baseTime);
+                    break;
+
+                case REQUEST_ADAPT:
+                case REQUEST_DEADLINE:
+                    Scheduler_AdaptJob(
+                        sched, index, REQUEST_TYPE(request), baseTime);
+                    break;
+
+                case REQUEST_PAUSE:
+                    job->isPaused = 1U;
+                    Scheduler_SetTableJob(sched, index, 0U);
+                    AtomicExchangeByte(&job->pending, 0U);
+                    break;
+
+                case REQUEST_RESUME:
+                    Scheduler_ResumeJob(sched, index, baseTime);
+                    break;
+
+                case REQUEST_TRIGGER:
+                case REQUEST_RESTART:
+                    Scheduler_TriggerJob(
+                        sched, index, REQUEST_TYPE(request), baseTime);
+                    break;
+
+                case REQUEST_CANCEL:
+                    Scheduler_ReleaseJob(sched, index);
+                    break;
+
+                default:
+                    break;
+            }
+
+            /* Re-insert the job with its new deadline */
+            if((job->isActive != 0U) && (job->isPaused == 0U) &&
+               (sched->isRunning != 0U))
+            {
+                SchedulerQueueInsert(sched, index);
+            }
+        }
+    }
+}
+
+/**
+ * @brief  This function copies the requested settings of a job to the settings
+ *         that are used by the processing of the scheduler.
+ *
+ * Each setting is requested by a single store, thus a setting is never applied
+ * partially, even if it is changed from an interrupt handler meanwhile.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void Scheduler_ApplySettings(Scheduler_t* const sched, const uint16_t index)
+{
+    Job_t* const job      = &sched->jobs[index];
+    JobData_t* const data = &sched->jobData[index];
+    const uint32_t window = data->requestedWindow;
+    const uint16_t policy = data->requestedPolicy;
+
+    job->windowStart  = (uint16_t)(window & 0x7FFU);
+    job->windowEnd    = (uint16_t)((window >> 11U) & 0x7FFU);
+    job->weekdays     = (uint8_t)(window >> 24U);
+    job->priority     = data->requestedPriority;
+    job->stretchLimit = data->requestedStretchLimit;
+
+    data->policy       = (uint8_t)(policy >> 8U);
+    data->catchUpLimit = (uint8_t)(policy & 0xFFU);
+}
+
+/**
+ * @brief  This function schedules a newly added or rescheduled job: the first
+ *         deadline of the job is calculated, or a triggered job is linked to
+ *         its predecessor.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param index     The index of the job.
+ * @param baseTime  The time (Unix epoch) of the processing step.
+ */
+void Scheduler_ScheduleJob(Scheduler_t* const sched,
+                           const uint16_t index,
+                           const uint32_t baseTime)
+{
+    Job_t* const job      = &sched->jobs[index];
+    JobData_t* const data = &sched->jobData[index];
+
+    job->slack       = data->requestedSlack;
+    data->phaseError = 0U;
+    if(job->type == SCHEDULER_JOB_DEFERRABLE)
+    {
+        sched->deferrable[index / 32U] |= 1UL << (index % 32U);
+    }
+    else
+    {
+        sched->deferrable[index / 32U] &= ~(1UL << (index % 32U));
+    }
+
+    if(job->type == SCHEDULER_JOB_TRIGGERED)
+    {
+        /* Executed after its predecessor instead */
+        Scheduler_LinkJob(sched, index);
+        job->isActive = 0U;
+    }
+    else if(job->type == SCHEDULER_JOB_TABLE)
+    {
+        /* Made ready by the static schedule instead, unless paused */
+        job->isActive = 0U;
+        Scheduler_SetTableJob(sched, index, (job->isPaused == 0U) ? 1U : 0U);
+    }
+    else
+    {
+        job->isActive =
+            Scheduler_GetFirstDeadline(sched, job, baseTime, &job->deadline);
+    }
+}
+
+/**
+ * @brief  This function releases the slot of a job. The generation of the slot
+ *         is incremented, thus the handles of the job become invalid.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void Scheduler_ReleaseJob(Scheduler_t* const sched, const uint16_t index)
+{
+    Job_t* const job      = &sched->jobs[index];
+    JobData_t* const data = &sched->jobData[index];
+
+    /* Cancel the triggered jobs of the job */
+    uint16_t successor = data->firstSuccessor;
+    while(successor != SCHEDULER_NO_JOB)
+    {
+        sched->jobData[successor].predecessor = SCHEDULER_NO_JOB;
+        (void)Scheduler_PostRequest(sched, successor, REQUEST_CANCEL);
+        successor = sched->jobData[successor].nextSibling;
+    }
+    data->firstSuccessor = SCHEDULER_NO_JOB;
+    Scheduler_UnlinkJob(sched, index);
+
+    job->isActive  = 0U;
+    job->isPaused  = 0U;
+    job->pending   = 0U;
+    ++job->generation;
+    if(job->generation == 0U)
+    {
+        job->generation = 1U;
+    }
+
+    sched->deferrable[index / 32U] &= ~(1UL << (index % 32U));
+    Scheduler_SetTableJob(sched, index, 0U);
+    AtomicFetchAnd(&sched->notify[index / 32U], ~(1UL << (index % 32U)));
+    AtomicFetchAnd(&sched->allocated[index / 32U], ~(1UL << (index % 32U)));
+}
+
+/**
+ * @brief  This function links a triggered job to the list of triggered jobs of
+ *         its predecessor. If the predecessor has been released meanwhile, the
+ *         job is released too.
+ *
+ * The job is inserted at the head of the list and the head is written last,
+ * thus the execution of the triggered jobs always finds a consistent list.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void Scheduler_LinkJob(Scheduler_t* const sched, const uint16_t index)
+{
+    JobData_t* const data      = &sched->jobData[index];
+    const uint16_t predecessor = data->predecessor;
+
+    if((predecessor != SCHEDULER_NO_JOB) &&
+       ((sched->allocated[predecessor / 32U] & (1UL << (predecessor % 32U))) !=
+        0U))
+    {
+        data->firstSuccessor = SCHEDULER_NO_JOB;
+        data->nextSibling    = sched->jobData[predecessor].firstSuccessor;
+        __DMB();
+        sched->jobData[predecessor].firstSuccessor = index;
+    }
+    else
+    {
+        data->predecessor = SCHEDULER_NO_JOB;
+        Scheduler_ReleaseJob(sched, index);
+    }
+}
+
+/**
+ * @brief  This function removes a triggered job from the list of triggered jobs
+ *         of its predecessor.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void Scheduler_UnlinkJob(Scheduler_t* const sched, const uint16_t index)
+{
+    JobData_t* const data = &sched->jobData[index];
+
+    if(data->predecessor != SCHEDULER_NO_JOB)
+    {
+        uint16_t* link = &sched->jobData[data->predecessor].firstSuccessor;
+        while((*link != SCHEDULER_NO_JOB) && (*link != index))
+        {
+            link = &sched->jobData[*link].nextSibling;
+        }
+        if(*link == index)
+        {
+            *link = data->nextSibling;
+        }
+
+        data->predecessor = SCHEDULER_NO_JOB;
+    }
+}
+
+/**
+ * @brief  This function starts the scheduler.
+ *
+ * The pending requests are applied and the deadlines of the jobs are shifted by
+ * the time elapsed since the scheduler was stopped, then the jobs are inserted
+ * into the queue. The deadlines of the calendar jobs are recalculated from the
+ * current time instead, since they are aligned to the calendar time.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ */
+void Scheduler_Start(Scheduler_t* const sched, const uint32_t currentTime)
+{
+    const uint32_t elapsedTime = currentTime - sched->referenceTime;
+
+    Scheduler_ApplyRequests(sched, currentTime);
+
+    SchedulerQueueInit(sched, currentTime);
+    for(uint_fast16_t i = 0U; i < sched->capacity; ++i)
+    {
+        Job_t* const job = &sched->jobs[i];
+
+        if(job->isActive != 0U)
+        {
+            if(job->type == SCHEDULER_JOB_CALENDAR)
+            {
+                job->isActive = Scheduler_GetFirstDeadline(
+                    sched, job, currentTime, &job->deadline);
+            }
+            else
+            {
+                uint32_t nominalTime = job->deadline - job->slack;
+                nominalTime += elapsedTime;
+                job->isActive = Scheduler_ApplyWindow(job, &nominalTime);
+                job->deadline = nominalTime + job->slack;
+            }
+        }
+
+        if((job->isActive != 0U) && (job->isPaused == 0U))
+        {
+            SchedulerQueueInsert(sched, i);
+        }
+    }
+
+    /* The static schedule keeps its phase as well */
+    sched->tableCycleStart += elapsedTime;
+
+    sched->isRunning = 1U;
+}
+
+/**
+ * @brief  This function stops the scheduler after processing the jobs. The
+ *         deadlines of the jobs are kept relative to the time of stopping.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ */
+void Scheduler_Stop(Scheduler_t* const sched, const uint32_t currentTime)
+{
+    /* Process the due jobs */
+    Scheduler_ApplyRequests(sched, currentTime);
+    Scheduler_ProcessDueJobs(sched, currentTime);
+
+    /* Stop the scheduler */
+    sched->referenceTime = currentTime;
+    sched->isRunning     = 0U;
+}
+
+/**
+ * @brief  This function sets the pending flag of each job that is due or whose
+ *         execution window has opened and calculates the next deadline of
+ *         these jobs.
+ *
+ * The due jobs are removed from the queue first. Then the jobs whose nominal
+ * time has been reached are removed in the order of their deadlines until the
+ * first job whose execution window has not opened yet. If any job has been
+ * executed, the deferrable jobs are executed upon the same wakeup.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ */
+void Scheduler_ProcessDueJobs(Scheduler_t* const sched,
+                              const uint32_t currentTime)
+{
+    uint16_t index     = 0U;
+    uint8_t isExecuted = 0U;
+
+    if(sched->table != NULL)
+    {
+        isExecuted = Scheduler_ProcessTable(sched, currentTime);
+    }
+
+    while(SchedulerQueuePopDue(sched, currentTime, &index) != 0U)
+    {
+        Scheduler_SetJobPending(sched, index, currentTime);
+        isExecuted = 1U;
+    }
+
+    while((SchedulerQueuePeek(sched, &index) != 0U) &&
+          ((sched->jobs[index].deadline - sched->jobs[index].slack) <=
+           currentTime))
+    {
+        SchedulerQueueRemove(sched, index);
+        Scheduler_SetJobPending(sched, index, currentTime);
+        isExecuted = 1U;
+    }
+
+    if(isExecuted != 0U)
+    {
+        Scheduler_ProcessDeferrableJobs(sched);
+        Scheduler_UpdateGovernor(sched, currentTime);
+        ++sched->stats.wakeups;
+    }
+}
+
+/**
+ * @brief  This function removes the scheduled deferrable jobs from the queue
+ *         and sets their pending flag, thus they are executed upon the current
+ *         wakeup instead of causing wakeups of their own.
+ *
+ * @param sched  Pointer to the scheduler.
+ */
+void Scheduler_ProcessDeferrableJobs(Scheduler_t* const sched)
+{
+    for(uint_fast16_t i = 0U; i < SCHEDULER_BITMAP_WORDS(sched->capacity); ++i)
+    {
+        uint32_t deferrable = sched->deferrable[i];
+
+        while(deferrable != 0U)
+        {
+            const uint_fast8_t bit = Scheduler_FindFirstSet(deferrable);
+            const uint16_t index   = (uint16_t)((i * 32U) + bit);
+            Job_t* const job       = &sched->jobs[index];
+            deferrable &= ~(1UL << bit);
+
+            /* A paused job stays scheduled until it is resumed */
+            if((job->isActive != 0U) && (job->isPaused == 0U))
+            {
+                SchedulerQueueRemove(sched, index);
+                Scheduler_ApplyPolicy(sched, index, 0U);
+                Scheduler_SetJobReady(sched, index);
+
+                /* The job is released after its execution */
+                job->isActive = 0U;
+                sched->deferrable[i] &= ~(1UL << bit);
+                ++sched->stats.coalescedJobs;
+            }
+        }
+    }
+}
+
+/**
+ * @brief  This function makes the table jobs of the reached wakeup entry of the
+ *         static schedule ready.
+ *
+ * On time, i.e. if only the current entry has been reached, the pending mask of
+ * the entry is merged into the ready masks at once: the cost is O(1) regardless
+ * of the number of jobs of the entry. Only the jobs whose previous execution is
+ * still pending are handled one by one, since their executions are set
+ * according to their missed-deadline policy. If more than one entry has been
+ * reached, e.g. after a stall, the entries are stepped through by
+ * Scheduler_ProcessLateTable().
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ * @return  A non-zero value if any entry has been reached; otherwise zero.
+ */
+uint8_t Scheduler_ProcessTable(Scheduler_t* const sched,
+                               const uint32_t currentTime)
+{
+    const SchedulerTable_t* const table = sched->table;
+    const SchedulerTableEntry_t* const entry =
+        &table->entries[sched->tablePosition];
+    const uint32_t nominalTime = sched->tableCycleStart + entry->offset;
+    uint32_t nextTime          = sched->tableCycleStart;
+    uint8_t isExecuted         = 0U;
+
+    /* The nominal time of the entry after the current one */
+    if((sched->tablePosition + 1U) < table->count)
+    {
+        nextTime += table->entries[sched->tablePosition + 1U].offset;
+    }
+    else
+    {
+        nextTime += table->hyperperiod + table->entries[0U].offset;
+    }
+
+    if(nominalTime > currentTime)
+    {
+        /* The current entry has not been reached yet */
+    }
+    else if(nextTime > currentTime)
+    {
+        /* Count the wakeup of the entry */
+        if(nominalTime > sched->stats.lastNominalTime)
+        {
+            ++sched->stats.nominalWakeups;
+            sched->stats.lastNominalTime = nominalTime;
+        }
+
+        Scheduler_SetTableJobsReady(sched, entry->pending);
+
+        /* Step to the next entry, wrapping around at the hyperperiod */
+        ++sched->tablePosition;
+        if(sched->tablePosition == table->count)
+        {
+            sched->tablePosition = 0U;
+            sched->tableCycleStart += table->hyperperiod;
+        }
+
+        isExecuted = 1U;
+    }
+    else
+    {
+        isExecuted = Scheduler_ProcessLateTable(sched, currentTime);
+    }
+
+    return isExecuted;
+}
+
+/**
+ * @brief  This function steps through the wakeup entries of the static
+ *         schedule that have been reached since the last processing and makes
+ *         the table jobs of their pending masks ready.
+ *
+ * Each entry costs O(1) plus the number of jobs in its pending mask, thus the
+ * late processing is O(count) in the number of reached entries. If more than a
+ * whole hyperperiod has passed since the current entry, e.g. after a long
+ * stall, the hyperperiods in between are skipped arithmetically, thus at most
+ * the entries of two hyperperiods are stepped through. The activations of each
+ * job are counted, then the pending executions are set once per job according
+ * to its missed-deadline policy, with all activations but the latest one
+ * counted as missed.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ * @return  A non-zero value if any entry has been reached; otherwise zero.
+ */
+uint8_t Scheduler_ProcessLateTable(Scheduler_t* const sched,
+                                   const uint32_t currentTime)
+{
+    const SchedulerTable_t* const table = sched->table;
+    const uint32_t cycles =
+        (currentTime - sched->tableCycleStart) / table->hyperperiod;
+    uint32_t activations[SCHEDULER_TABLE_MAX_JOBS];
+    uint32_t reached   = 0U;
+    uint8_t isExecuted = 0U;
+
+    for(uint_fast8_t i = 0U; i < SCHEDULER_TABLE_MAX_JOBS; ++i)
+    {
+        activations[i] = 0U;
+    }
+
+    /* Skip the whole hyperperiods in between: each entry has been reached once
+     * per hyperperiod, starting from the current position */
+    if((currentTime > sched->tableCycleStart) && (cycles > 1U))
+    {
+        for(uint_fast16_t position = 0U; position < table->count; ++position)
+        {
+            uint32_t pending = table->entries[position].pending;
+            reached |= pending;
+
+            while(pending != 0U)
+            {
+                const uint_fast8_t bit = Scheduler_FindFirstSet(pending);
+                activations[bit] += cycles - 1U;
+                pending &= ~(1UL << bit);
+            }
+        }
+
+        sched->tableCycleStart += (cycles - 1U) * table->hyperperiod;
+        sched->stats.nominalWakeups += (cycles - 1U) * table->count;
+        isExecuted = 1U;
+    }
+
+    for(;;)
+    {
+        const SchedulerTableEntry_t* const entry =
+            &table->entries[sched->tablePosition];
+        const uint32_t nominalTime = sched->tableCycleStart + entry->offset;
+        uint32_t pending           = entry->pending;
+
+        if(nominalTime > currentTime)
+        {
+            break;
+        }
+
+        /* Count the wakeup of the entry */
+        if(nominalTime > sched->stats.lastNominalTime)
+        {
+            ++sched->stats.nominalWakeups;
+            sched->stats.lastNominalTime = nominalTime;
+        }
+
+        /* Count the activations of the jobs of the entry */
+        reached |= pending;
+        while(pending != 0U)
+        {
+            const uint_fast8_t bit = Scheduler_FindFirstSet(pending);
+            ++activations[bit];
+            pending &= ~(1UL << bit);
+        }
+
+        /* Step to the next entry, wrapping around at the hyperperiod */
+        ++sched->tablePosition;
+        if(sched->tablePosition == table->count)
+        {
+            sched->tablePosition = 0U;
+            sched->tableCycleStart += table->hyperperiod;
+        }
+
+        isExecuted = 1U;
+    }
+
+    /* Make the reached table jobs ready. The bits that do not refer to a table
+     * job are ignored, e.g. after the job has been cancelled. */
+    reached &= sched->tableJobs;
+    while(reached != 0U)
+    {
+        const uint_fast8_t index = Scheduler_FindFirstSet(reached);
+        reached &= ~(1UL << index);
+
+        Scheduler_SetTableJobPending(
+            sched, (uint16_t)index, activations[index] - 1U);
+    }
+
+    return isExecuted;
+}
+
+/**
+ * @brief  This function makes the table jobs of a pending mask ready for one
+ *         execution each.
+ *
+ * The bits that do not refer to a table job are ignored, e.g. after the job has
+ * been cancelled. The execution of each job is recorded in the table pending
+ * mask and the jobs are marked in the ready and notify masks at once. A job
+ * whose previous execution is still pending is an overrun: its executions are
+ * set by Scheduler_SetTableJobPending() instead.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param jobs   The pending mask of the reached wakeup entry.
+ */
+void Scheduler_SetTableJobsReady(Scheduler_t* const sched, const uint32_t jobs)
+{
+    const uint32_t tableJobs = jobs & sched->tableJobs;
+    const uint32_t marked    = sched->ready[0U] | sched->notify[0U];
+
+    /* The jobs that are still marked have not been executed yet */
+    uint32_t overruns     = tableJobs & (sched->tablePending | marked);
+    const uint32_t onTime = tableJobs & ~overruns;
+
+    AtomicFetchOr(&sched->tablePending, onTime);
+    AtomicFetchOr(&sched->ready[0U], onTime & ~sched->tableNotify);
+    AtomicFetchOr(&sched->notify[0U], onTime & sched->tableNotify);
+
+    while(overruns != 0U)
+    {
+        const uint_fast8_t index = Scheduler_FindFirstSet(overruns);
+        overruns &= ~(1UL << index);
+
+        Scheduler_SetTableJobPending(sched, (uint16_t)index, 0U);
+    }
+}
+
+/**
+ * @brief  This function sets the pending executions of a table job according
+ *         to its missed-deadline policy and marks the job as ready.
+ *
+ * The execution that is recorded in the table pending mask is taken over into
+ * the pending executions of the job first, thus the policy sees all the
+ * executions that are still pending.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param index   The index of the job.
+ * @param missed  The number of missed activations of the job.
+ */
+void Scheduler_SetTableJobPending(Scheduler_t* const sched,
+                                  const uint16_t index,
+                                  const uint32_t missed)
+{
+    Job_t* const job   = &sched->jobs[index];
+    const uint32_t bit = 1UL << index;
+
+    assert_param(index < SCHEDULER_TABLE_MAX_JOBS);
+
+    if((AtomicFetchAnd(&sched->tablePending, ~bit) & bit) != 0U)
+    {
+        ++job->pending;
+    }
+
+    if(job->pending != 0U)
+    {
+        ++sched->stats.overruns;
+    }
+    sched->stats.missedActivations += missed;
+    Scheduler_ApplyPolicy(sched, index, missed);
+    Scheduler_SetJobReady(sched, index);
+}
+
+/**
+ * @brief  This function updates whether a table job is made ready by the
+ *         static schedule.
+ *
+ * A job that is no longer made ready, i.e. a paused or released job, drops the
+ * execution recorded in the table pending mask as well.
+ *
+ * @param sched       Pointer to the scheduler.
+ * @param index       The index of the job.
+ * @param isEligible  Non-zero if the job is made ready by the static schedule.
+ */
+void Scheduler_SetTableJob(Scheduler_t* const sched,
+                           const uint16_t index,
+                           const uint8_t isEligible)
+{
+    if(index >= SCHEDULER_TABLE_MAX_JOBS)
+    {
+        /* Out of range of the pending masks, never a table job */
+    }
+    else if(isEligible != 0U)
+    {
+        sched->tableJobs |= 1UL << index;
+        if(sched->jobData[index].callback == NULL)
+        {
+            sched->tableNotify |= 1UL << index;
+        }
+        else
+        {
+            sched->tableNotify &= ~(1UL << index);
+        }
+    }
+    else
+    {
+        sched->tableJobs &= ~(1UL << index);
+        sched->tableNotify &= ~(1UL << index);
+        AtomicFetchAnd(&sched->tablePending, ~(1UL << index));
+    }
+}
 
 /**
- * @brief  Initialize the scheduler by setting its structure values to zero.
+ * @brief  This function takes over the execution of a table job that has been
+ *         recorded in the table pending mask.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ * @return  The number of executions taken over, i.e. one or zero.
  */
-void SchedulerInit(void)
+uint8_t Scheduler_TakeTableExecution(Scheduler_t* const sched,
+                                     const uint16_t index)
 {
-    scheduler.startTime = 0U;
-    scheduler.isRunning = 0U;
-    scheduler.numOfJobs = 0U;
+    uint8_t result = 0U;
+
+    if((index < SCHEDULER_TABLE_MAX_JOBS) &&
+       ((AtomicFetchAnd(&sched->tablePending, ~(1UL << index)) &
+         (1UL << index)) != 0U))
+    {
+        result = 1U;
+    }
+    else
+    {
+        /* No execution recorded */
+    }
+
+    return result;
 }
 
 /**
- * @brief  Add a new job to the scheduler.
+ * @brief  This function sets the pending flag of a job that has been removed
+ *         from the queue, calculates its next deadline and re-inserts it into
+ *         the queue.
  *
- * @param period    The period in [s] which the job needs to be executed.
- * @param callback  The callback function that is called upon job execution.
- * @return  A non-zero value if the job has been successfully added; othwerwise
- *          zero.
+ * The deadlines of the job are kept on the grid of its first deadline, i.e. the
+ * next nominal deadline is the first deadline plus a whole number of periods.
+ * The processing time, a late wakeup or the slack of the job do not shift the
+ * later deadlines of the job. The deadlines outside of the active window of the
+ * job are skipped. A one-shot job is not re-inserted: it is released after its
+ * execution.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param index        The index of the job.
+ * @param currentTime  The current time (Unix epoch).
  */
-uint8_t SchedulerAddJob(const uint32_t period, const Callback_t callback)
+void Scheduler_SetJobPending(Scheduler_t* const sched,
+                             const uint16_t index,
+                             const uint32_t currentTime)
 {
-    uint8_t result = 0U;
+    Job_t* const job      = &sched->jobs[index];
+    JobData_t* const data = &sched->jobData[index];
+    uint32_t nominalTime  = job->deadline - job->slack;
+    uint32_t missed       = 0U;
 
-    assert_param(period > 0U);
-    assert_param(callback != NULL);
+    /* Count the wakeup that the job would have needed at its nominal time */
+    if(nominalTime > sched->stats.lastNominalTime)
+    {
+        ++sched->stats.nominalWakeups;
+        sched->stats.lastNominalTime = nominalTime;
+    }
+
+    /* The activations of a stretched job are the multiples of its stretched
+     * period, thus the missed activations are counted with the same period */
+    const uint32_t period = Scheduler_GetStretchedPeriod(sched, job);
+
+    /* The lateness of the execution with respect to the anchored phase */
+    if(period != 0U)
+    {
+        missed = (currentTime - nominalTime) / period;
+    }
+    data->phaseError = ((currentTime - nominalTime) < SCHEDULER_MAX_PERIOD)
+                           ? (SchedulerPeriod_t)(currentTime - nominalTime)
+                           : (SchedulerPeriod_t)SCHEDULER_MAX_PERIOD;
+
+    /* Detect the overload and the missed activations */
+    if(job->pending != 0U)
+    {
+        ++sched->stats.overruns;
+    }
+    sched->stats.missedActivations += missed;
 
-    if(scheduler.isRunning == 0U)
+    /* Job is ready: set the pending executions according to the policy if
+     * the latest activation is within the active window of the job */
+    nominalTime += missed * period;
+    const uint8_t isInWindow =
+        (Scheduler_GetWindowOpening(job, nominalTime) == nominalTime) ? 1U
+                                                                      : 0U;
+    if(isInWindow != 0U)
+    {
+        Scheduler_ApplyPolicy(sched, index, missed);
+        Scheduler_SetJobReady(sched, index);
+    }
+
+    if((job->type == SCHEDULER_JOB_DEFERRABLE) && (isInWindow != 0U))
+    {
+        /* The maximum latency of the job has passed: the job is released after
+         * its execution */
+        job->isActive = 0U;
+        sched->deferrable[index / 32U] &= ~(1UL << (index % 32U));
+    }
+    else if((job->type == SCHEDULER_JOB_ONE_SHOT) && (isInWindow != 0U))
+    {
+        /* The job is released after its execution */
+        job->isActive = 0U;
+    }
+    else
     {
-        if(scheduler.numOfJobs < MAX_NUM_OF_JOBS)
+        /* Advance the nominal deadline by whole periods past the current time,
+         * thus the lateness never accumulates */
+        nominalTime += period;
+        job->slack    = data->requestedSlack;
+        job->isActive = Scheduler_ApplyWindow(job, &nominalTime);
+        job->deadline = nominalTime + job->slack;
+
+        /* Re-insert the job into the queue */
+        if(job->isActive != 0U)
         {
-            scheduler.jobs[scheduler.numOfJobs].period        = period;
-            scheduler.jobs[scheduler.numOfJobs].remainingTime = period;
-            scheduler.jobs[scheduler.numOfJobs].isPending     = 0U;
-            scheduler.jobs[scheduler.numOfJobs].callback      = callback;
-            ++scheduler.numOfJobs;
+            SchedulerQueueInsert(sched, index);
         }
-        else
+    }
+}
+
+/**
+ * @brief  This function counts a wakeup of the scheduler and adjusts the
+ *         stretch level of the wakeup governor.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ */
+void Scheduler_UpdateGovernor(Scheduler_t* const sched,
+                              const uint32_t currentTime)
+{
+    const uint32_t budget = sched->wakeupBudget;
+
+    ++sched->governorWakeups;
+
+    if(budget == 0U)
+    {
+        /* Governor is disabled: restore the periods */
+        sched->stats.governorLevel = 0U;
+        sched->governorWakeups     = 0U;
+        sched->governorWindowStart = currentTime;
+    }
+    else if(sched->governorWakeups > budget)
+    {
+        /* Budget exceeded within the window: stretch more jobs, unless every
+         * job has reached its stretch limit */
+        if((sched->stats.governorLevel < GOVERNOR_MAX_LEVEL) &&
+           (sched->governorHeadroom != 0U))
+        {
+            ++sched->stats.governorLevel;
+            sched->governorHeadroom = 0U;
+        }
+        sched->governorWakeups     = 0U;
+        sched->governorWindowStart = currentTime;
+    }
+    else if((currentTime - sched->governorWindowStart) >= SECONDS_PER_HOUR)
+    {
+        /* Window elapsed: restore the periods step by step if the load has
+         * dropped to half of the budget */
+        if((sched->governorWakeups <= (budget / 2U)) &&
+           (sched->stats.governorLevel > 0U))
         {
-            result = 0U;
+            --sched->stats.governorLevel;
         }
+        sched->governorWakeups     = 0U;
+        sched->governorWindowStart = currentTime;
     }
     else
     {
-        result = 0U;
+        /* Window in progress */
     }
-
-    return result;
 }
 
 /**
- * @brief  Process the scheduler.
+ * @brief  This function returns the period of a job stretched by the wakeup
+ *         governor and counts the stretching.
  *
- * This function needs to be called each time upon an RTC alarm interrupt. The
- * function checks all jobs whether they need to be executed and sets the
- * appropriate pending flags.
+ * The period of a periodic job is doubled once for each level of the governor
+ * above the priority class of the job, up to the stretch limit of the job.
  *
- * @note  The function does not automatically execute the callbacks of the
- *        pending jobs to provide more flexibility for the application.
- *        The pending jobs can be executed by calling the
- *        ::SchedulerExecutePendingJobs() function.
+ * @param sched  Pointer to the scheduler.
+ * @param job    Pointer to the job.
+ * @return  The stretched period in [s], which is a multiple of the period.
  */
-void SchedulerProcess(void)
+uint32_t Scheduler_GetStretchedPeriod(Scheduler_t* const sched,
+                                      const Job_t* const job)
 {
-    uint8_t isScheduleNextJob = 0U;
+    const uint32_t level  = sched->stats.governorLevel;
+    const uint32_t factor = Scheduler_GetStretchFactor(job, level);
+    const uint32_t period = job->period;
 
-    if(scheduler.isRunning != 0U)
+    if(Scheduler_GetStretchFactor(job, level + 1U) > factor)
     {
-        const uint32_t elapsedTime = RtcGetEpoch() - scheduler.startTime;
-        if(elapsedTime > 0U)
-        {
-            /* Process the remaining time of the jobs */
-            Scheduler_ProcessRemainingTime(elapsedTime);
+        sched->governorHeadroom = 1U;
+    }
+
+    if(factor > 1U)
+    {
+        ++sched->stats.stretchedActivations;
+        sched->stats.stretchedTime += (factor - 1U) * period;
+    }
+
+    return factor * period;
+}
+
+/**
+ * @brief  This function returns the factor by which the period of a job is
+ *         stretched at a given level of the wakeup governor.
+ *
+ * @param job    Pointer to the job.
+ * @param level  The stretch level of the governor.
+ * @return  The factor of the period, limited by the stretch limit of the job
+ *          and by the maximum period.
+ */
+uint32_t Scheduler_GetStretchFactor(const Job_t* const job,
+                                    const uint32_t level)
+{
+    const uint32_t offset = SCHEDULER_PRIORITY_LOW - (uint32_t)job->priority;
+    uint32_t factor       = 1U;
 
-            /* Schedule next job */
-            isScheduleNextJob = 1U;
+    if((job->type == SCHEDULER_JOB_PERIODIC) &&
+       (job->priority != SCHEDULER_PRIORITY_CRITICAL) && (level > offset))
+    {
+        factor = ((level - offset) < 8U) ? (1UL << (level - offset)) : 256U;
+        if(factor > job->stretchLimit)
+        {
+            factor = job->stretchLimit;
         }
-        else
+        if(factor > (SCHEDULER_MAX_PERIOD / job->period))
+        {
+            factor = SCHEDULER_MAX_PERIOD / job->period;
+        }
+    }
+
+    return factor;
+}
+
+/**
+ * @brief  This function sets the number of pending executions of a due job
+ *         according to its missed-deadline policy.
+ *
+ * The number of pending executions is bounded, thus a long stall does not
+ * result in a burst of executions: a job with the ::SCHEDULER_POLICY_CATCH_UP
+ * policy has at most one execution plus its catch-up limit pending.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param index   The index of the job.
+ * @param missed  The number of activations missed before the current one.
+ */
+void Scheduler_ApplyPolicy(Scheduler_t* const sched,
+                           const uint16_t index,
+                           const uint32_t missed)
+{
+    Job_t* const job            = &sched->jobs[index];
+    const JobData_t* const data = &sched->jobData[index];
+
+    switch(data->policy)
+    {
+        case SCHEDULER_POLICY_SKIP:
+            if(missed == 0U)
+            {
+                job->pending = 1U;
+            }
+            else
+            {
+                ++sched->stats.skippedExecutions;
+            }
+            break;
+
+        case SCHEDULER_POLICY_CATCH_UP:
         {
-            /* Elapsed time is zero: no need to process and schedule jobs */
-            isScheduleNextJob = 0U;
+            const uint32_t limit = (uint32_t)data->catchUpLimit + 1U;
+            uint32_t pending =
+                (uint32_t)job->pending + 1U +
+                ((missed < data->catchUpLimit) ? missed : data->catchUpLimit);
+            if(pending > limit)
+            {
+                pending = limit;
+            }
+            job->pending = (uint8_t)pending;
+            break;
         }
+
+        case SCHEDULER_POLICY_RUN_ONCE:
+        default:
+            job->pending = 1U;
+            break;
+    }
+}
+
+/**
+ * @brief  This function marks a job that has pending executions as ready for
+ *         execution. A job without a callback is marked for notification
+ *         instead.
+ *
+ * The bit of the job is set after its pending executions have been written,
+ * thus the execution of the pending jobs never finds a ready job without its
+ * executions.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void Scheduler_SetJobReady(Scheduler_t* const sched, const uint16_t index)
+{
+    const uint32_t mask = 1UL << (index % 32U);
+
+    if(sched->jobs[index].pending == 0U)
+    {
+        /* Nothing to execute */
+    }
+    else if(sched->jobData[index].callback == NULL)
+    {
+        AtomicFetchOr(&sched->notify[index / 32U], mask);
     }
     else
     {
-        /* Scheduler is not running: start the scheduler */
-        isScheduleNextJob = 1U;
+        AtomicFetchOr(&sched->ready[index / 32U], mask);
     }
+}
+
+/**
+ * @brief  This function executes the triggered jobs of a job, including their
+ *         own triggered jobs, in depth-first order.
+ *
+ * The tree of the triggered jobs is walked without recursion along the links of
+ * the jobs. If a job is unlinked by the processing meanwhile, the walk ends at
+ * that job.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job that has been executed.
+ */
+void Scheduler_ExecuteSuccessors(Scheduler_t* const sched,
+                                 const uint16_t index)
+{
+    uint16_t current = sched->jobData[index].firstSuccessor;
 
-    /* Schedule next job */
-    if(isScheduleNextJob != 0U)
+    while(current != SCHEDULER_NO_JOB)
     {
-        /* Search for the next job with the lowest remaining time */
-        uint8_t indexOfNextJob = 0;
-        for(uint_fast8_t i = 0U; i < scheduler.numOfJobs; ++i)
+        const Job_t* const job      = &sched->jobs[current];
+        const JobData_t* const data = &sched->jobData[current];
+
+        if((job->isPaused == 0U) && (data->callback != NULL))
         {
-            if(scheduler.jobs[i].remainingTime <
-               scheduler.jobs[indexOfNextJob].remainingTime)
-            {
-                indexOfNextJob = i;
-            }
+            sched->currentJob = HANDLE_MAKE(current, job->generation);
+            data->callback(data->context);
         }
 
-        /* Set RTC alarm for next job */
-        if(scheduler.jobs[indexOfNextJob].remainingTime > 0U)
+        if((job->isPaused == 0U) && (data->firstSuccessor != SCHEDULER_NO_JOB))
         {
-            scheduler.startTime = RtcGetEpoch();
-            if(RtcSetAlarmFromEpoch(
-                   scheduler.startTime +
-                   scheduler.jobs[indexOfNextJob].remainingTime) != 0U)
+            /* Continue with the triggered jobs of the job */
+            current = data->firstSuccessor;
+        }
+        else
+        {
+            /* Continue with the next sibling of the job or of its closest
+             * predecessor that has one */
+            while((current != index) && (current != SCHEDULER_NO_JOB) &&
+                  (sched->jobData[current].nextSibling == SCHEDULER_NO_JOB))
             {
-                scheduler.isRunning = 1U;
+                current = sched->jobData[current].predecessor;
             }
+            current = ((current != index) && (current != SCHEDULER_NO_JOB))
+                          ? sched->jobData[current].nextSibling
+                          : SCHEDULER_NO_JOB;
         }
     }
 }
 
 /**
- * @brief  Execute the pending jobs.
+ * @brief  This function selects the ready job that needs to be executed first
+ *         by walking the set bits of the ready bitmask.
  *
- * This function checks the current state of each job. If a job is pending, its
- * callback is executed.
- *
- * @note  The processing function of the scheduler does not automatically
- *        execute the callbacks of the pending jobs. Therefore, this function
- *        must be called after calling the processing function of the scheduler.
+ * The job with the highest priority class is selected, and among the jobs of
+ * the same class the one with the earliest deadline.
  *
- * @warning  Depending on the implementation, this function may be called from
- *           an interrupt context, or a task context (or both). Consequently,
- *           the callback functions of the jobs are executed from the same
- *           context. This must be taken into account, i.e. care must be taken
- *           upon writing the callbacks of the jobs. For instance, calling this
- *           function from an ISR means that the jobs are also executed within
- *           the context of the ISR, thus the callbacks must not block and they
- *           can only call interrupt-safe RTOS API functions.
+ * @param sched  Pointer to the scheduler.
+ * @return  The index of the selected job, or ::SCHEDULER_NO_JOB if no job is
+ *          ready for execution.
  */
-void SchedulerExecutePendingJobs(void)
+uint16_t Scheduler_SelectReadyJob(const Scheduler_t* const sched)
 {
-    for(uint_fast8_t i = 0U; i < scheduler.numOfJobs; ++i)
+    uint16_t selected = SCHEDULER_NO_JOB;
+    const Job_t* best = NULL;
+
+    for(uint_fast16_t i = 0U; i < SCHEDULER_BITMAP_WORDS(sched->capacity); ++i)
     {
-        if(scheduler.jobs[i].isPending != 0U)
+        uint32_t ready = sched->ready[i];
+
+        while(ready != 0U)
         {
-            /* Execute job callback */
-            if(scheduler.jobs[i].callback != 0U)
+            const uint_fast8_t bit = Scheduler_FindFirstSet(ready);
+            const uint16_t index   = (uint16_t)((i * 32U) + bit);
+            const Job_t* const job = &sched->jobs[index];
+            ready &= ~(1UL << bit);
+
+            if((best == NULL) || (job->priority < best->priority) ||
+               ((job->priority == best->priority) &&
+                (job->deadline < best->deadline)))
             {
-                scheduler.jobs[i].callback();
+                selected = index;
+                best     = job;
             }
+        }
+    }
+
+    return selected;
+}
+
+/**
+ * @brief  This function counts the jobs that are ready for execution.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @return  The number of the set bits of the ready bitmask.
+ */
+uint32_t Scheduler_CountReadyJobs(const Scheduler_t* const sched)
+{
+    uint32_t count = 0U;
+
+    for(uint_fast16_t i = 0U; i < SCHEDULER_BITMAP_WORDS(sched->capacity); ++i)
+    {
+        uint32_t ready = sched->ready[i];
+
+        /* Clear the lowest set bit per step */
+        while(ready != 0U)
+        {
+            ready &= ready - 1U;
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief  This function snaps a period to the nearest multiple of the base
+ *         period of the harmonic registration mode if the difference is within
+ *         the configured tolerance.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param period  The period in [s].
+ * @return  The snapped period, or the original period if the mode is disabled
+ *          or the difference is out of tolerance.
+ */
+uint32_t Scheduler_SnapPeriod(const Scheduler_t* const sched,
+                              const uint32_t period)
+{
+    uint32_t result     = period;
+    const uint32_t base = sched->harmonicBase;
+
+    if(base != 0U)
+    {
+        uint64_t multiple =
+            (((uint64_t)period + (base / 2U)) / base) * (uint64_t)base;
+        if(multiple == 0U)
+        {
+            multiple = base;
+        }
 
-            /* Reset pending flag */
-            scheduler.jobs[i].isPending = 0U;
+        const uint64_t difference = (multiple > period) ? (multiple - period)
+                                                        : (period - multiple);
+        if(((difference * 100U) <=
+            ((uint64_t)sched->harmonicTolerance * period)) &&
+           (multiple <= 0xFFFFFFFFU))
+        {
+            result = (uint32_t)multiple;
         }
     }
+    else
+    {
+        result = period;
+    }
+
+    return result;
 }
 
 /**
- * @brief  Stop the scheduler.
+ * @brief  This function calculates the first deadline of a job that is added or
+ *         rescheduled.
  *
- * This function stops the running scheduler and deactivates the RTC alarm. The
- * function also processes the jobs.
+ * The first deadline of a calendar job is its next matching time after the base
+ * time. In the harmonic registration mode, the first deadline of a periodic job
+ * without a delayed start whose period is a multiple of the base period is
+ * aligned to the next multiple of the period. Otherwise, the first deadline is
+ * the delay of the job after the base time. The deadline is then moved into the
+ * active window of the job.
  *
- * @note  The function does not automatically execute the callbacks of the
- *        pending jobs to provide more flexibility for the application.
- *        The pending jobs can be executed by calling the
- *        ::SchedulerExecutePendingJobs() function.
+ * @param sched     Pointer to the scheduler.
+ * @param job       Pointer to the job.
+ * @param baseTime  The time (Unix epoch) of adding the job.
+ * @param deadline  Pointer where the first deadline of the job, including its
+ *                  slack, is written.
+ * @return  A non-zero value if the job has a deadline within its active window;
+ *          otherwise zero.
  */
-void SchedulerStop(void)
+uint8_t Scheduler_GetFirstDeadline(const Scheduler_t* const sched,
+                                   const Job_t* const job,
+                                   const uint32_t baseTime,
+                                   uint32_t* const deadline)
 {
-    if(scheduler.isRunning != 0U)
+    const uint32_t period = job->period;
+    uint32_t nominalTime  = 0U;
+    uint8_t result        = 0U;
+
+    if(job->type == SCHEDULER_JOB_CALENDAR)
+    {
+        nominalTime = (baseTime + period) - ((baseTime - job->offset) % period);
+    }
+    else if((job->type == SCHEDULER_JOB_PERIODIC) && (job->offset == period) &&
+            (sched->harmonicBase != 0U) &&
+            ((period % sched->harmonicBase) == 0U))
     {
-        /* Deactivate RTC alarm */
-        RtcDeactivateAlarm();
+        nominalTime = (baseTime - (baseTime % period)) + period;
+    }
+    else
+    {
+        nominalTime = baseTime + job->offset;
+    }
+
+    result    = Scheduler_ApplyWindow(job, &nominalTime);
+    *deadline = nominalTime + job->slack;
+
+    return result;
+}
+
+/**
+ * @brief  This function applies the backoff or the explicit next deadline of a
+ *         periodic job.
+ *
+ * The requested period replaces the period of the job. Upon a backoff, the next
+ * nominal deadline is the latest activation of the job plus the new period,
+ * moved forward by whole new periods if it has already passed, thus the phase
+ * of the job is kept. Upon an explicit deadline, the grid of the job is
+ * anchored to the requested deadline instead. A job that has not been
+ * scheduled yet is scheduled with the new period as if it had been added.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param index     The index of the job.
+ * @param type      The type of the request: ADAPT or DEADLINE.
+ * @param baseTime  The time (Unix epoch) of the processing step.
+ */
+void Scheduler_AdaptJob(Scheduler_t* const sched,
+                        const uint16_t index,
+                        const uint32_t type,
+                        const uint32_t baseTime)
+{
+    Job_t* const job      = &sched->jobs[index];
+    JobData_t* const data = &sched->jobData[index];
+    const uint32_t period = data->requestedPeriod;
+    uint32_t nominalTime  = 0U;
 
-        const uint32_t elapsedTime = RtcGetEpoch() - scheduler.startTime;
-        if(elapsedTime > 0U)
+    if(type == REQUEST_DEADLINE)
+    {
+        nominalTime = (data->requestedDeadline > baseTime)
+                          ? data->requestedDeadline
+                          : baseTime;
+    }
+    else if(job->isActive != 0U)
+    {
+        nominalTime = (job->deadline - job->slack - job->period) + period;
+        if(nominalTime < baseTime)
         {
-            /* Process the remaining time of the jobs */
-            Scheduler_ProcessRemainingTime(elapsedTime);
+            nominalTime += (((baseTime - nominalTime) + period - 1U) / period) *
+                           period;
         }
-        else
+    }
+    else
+    {
+        /* The job has not been scheduled yet */
+    }
+
+    job->period = (SchedulerPeriod_t)period;
+    job->slack  = data->requestedSlack;
+
+    if((type == REQUEST_DEADLINE) || (job->isActive != 0U))
+    {
+        job->isActive = Scheduler_ApplyWindow(job, &nominalTime);
+        job->deadline = nominalTime + job->slack;
+    }
+    else
+    {
+        data->phaseError = 0U;
+        job->isActive =
+            Scheduler_GetFirstDeadline(sched, job, baseTime, &job->deadline);
+    }
+}
+
+/**
+ * @brief  This function resumes a paused job.
+ *
+ * The next nominal deadline is the first deadline on the grid of the job that
+ * has not passed yet. The deadline of a calendar job is recalculated, and a job
+ * that has not been scheduled yet is scheduled as if it had been added.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param index     The index of the job.
+ * @param baseTime  The time (Unix epoch) of the processing step.
+ */
+void Scheduler_ResumeJob(Scheduler_t* const sched,
+                         const uint16_t index,
+                         const uint32_t baseTime)
+{
+    Job_t* const job      = &sched->jobs[index];
+    const uint32_t period = job->period;
+    uint32_t nominalTime  = job->deadline - job->slack;
+
+    job->isPaused = 0U;
+    job->slack    = sched->jobData[index].requestedSlack;
+
+    if(job->type == SCHEDULER_JOB_TRIGGERED)
+    {
+        /* Executed after its predecessor again */
+    }
+    else if(job->type == SCHEDULER_JOB_TABLE)
+    {
+        /* Made ready by the static schedule again */
+        Scheduler_SetTableJob(sched, index, 1U);
+    }
+    else if((job->isActive != 0U) && (job->type != SCHEDULER_JOB_CALENDAR))
+    {
+        if((period != 0U) && (nominalTime < baseTime))
         {
-            /* Elapsed time is zero: no need to process and schedule jobs */
+            nominalTime += (((baseTime - nominalTime) + period - 1U) / period) *
+                           period;
         }
+        job->isActive = Scheduler_ApplyWindow(job, &nominalTime);
+        job->deadline = nominalTime + job->slack;
+    }
+    else
+    {
+        job->isActive =
+            Scheduler_GetFirstDeadline(sched, job, baseTime, &job->deadline);
+    }
+}
+
+/**
+ * @brief  This function makes a job ready for an immediate execution.
+ *
+ * Upon a restart, the next nominal deadline of a periodic job is one period
+ * after the processing step. Otherwise, the schedule of the job is kept.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param index     The index of the job.
+ * @param type      The type of the request: TRIGGER or RESTART.
+ * @param baseTime  The time (Unix epoch) of the processing step.
+ */
+void Scheduler_TriggerJob(Scheduler_t* const sched,
+                          const uint16_t index,
+                          const uint32_t type,
+                          const uint32_t baseTime)
+{
+    Job_t* const job      = &sched->jobs[index];
+    JobData_t* const data = &sched->jobData[index];
+
+    /* The policy sees the execution recorded by the static schedule too */
+    job->pending += Scheduler_TakeTableExecution(sched, index);
+    Scheduler_ApplyPolicy(sched, index, 0U);
+    Scheduler_SetJobReady(sched, index);
+
+    if((type == REQUEST_RESTART) && (job->type == SCHEDULER_JOB_PERIODIC))
+    {
+        uint32_t nominalTime = baseTime + job->period;
 
-        /* Stop the scheduler */
-        scheduler.isRunning = 0U;
+        job->slack       = data->requestedSlack;
+        job->isActive    = Scheduler_ApplyWindow(job, &nominalTime);
+        job->deadline    = nominalTime + job->slack;
+        data->phaseError = 0U;
     }
     else
     {
-        /* Scheduler is already stopped: do nothing */
+        /* The schedule of the job is kept */
     }
 }
 
 /**
- * @brief  This function calculates the remaining time for each job.
+ * @brief  This function moves a nominal deadline of a job to the earliest
+ *         deadline within the active window of the job that is on the grid of
+ *         the original deadline, i.e. a whole number of periods later.
  *
- * @param elapsedTime  The elapsed time since the launch of the scheduler.
+ * @param job   Pointer to the job.
+ * @param time  Pointer to the nominal deadline (Unix epoch) to be moved.
+ * @return  A non-zero value if a deadline within the window has been found;
+ *          otherwise zero.
  */
-void Scheduler_ProcessRemainingTime(const uint32_t elapsedTime)
+uint8_t Scheduler_ApplyWindow(const Job_t* const job, uint32_t* const time)
 {
-    for(uint_fast8_t i = 0U; i < scheduler.numOfJobs; ++i)
+    uint8_t result     = 0U;
+    uint32_t candidate = *time;
+
+    for(uint_fast8_t i = 0U; (i < WINDOW_MAX_STEPS) && (result == 0U); ++i)
     {
-        if(elapsedTime >= scheduler.jobs[i].remainingTime)
+        const uint32_t opening = Scheduler_GetWindowOpening(job, candidate);
+        if(opening == candidate)
+        {
+            *time  = candidate;
+            result = 1U;
+        }
+        else if(job->period != 0U)
         {
-            /* Job is ready: reset remaining time and set pending flag */
-            scheduler.jobs[i].remainingTime = scheduler.jobs[i].period;
-            scheduler.jobs[i].isPending     = 1U;
+            /* Continue from the first deadline on the grid after the opening */
+            const uint32_t remainder = (opening - *time) % job->period;
+            candidate =
+                opening + ((remainder != 0U) ? (job->period - remainder) : 0U);
         }
         else
         {
-            /* Decrease remaining time */
-            scheduler.jobs[i].remainingTime -= elapsedTime;
+            candidate = opening;
         }
     }
+
+    return result;
+}
+
+/**
+ * @brief  This function returns the earliest time within the active window of
+ *         a job that is not earlier than a given time.
+ *
+ * The weekday is derived from the Unix epoch in the same way as the calendar of
+ * the RTC, i.e. the epoch started on a Thursday.
+ *
+ * @param job   Pointer to the job.
+ * @param time  The time (Unix epoch).
+ * @return  The time itself if it is within the window; otherwise the next
+ *          opening of the window.
+ */
+uint32_t Scheduler_GetWindowOpening(const Job_t* const job, const uint32_t time)
+{
+    const uint32_t day = time / SECONDS_PER_DAY;
+    uint32_t opening   = time;
+
+    for(uint_fast8_t i = 0U; i <= 7U; ++i)
+    {
+        const uint32_t weekday  = (((day + i) + 3U) % 7U) + RTC_WEEKDAY_MONDAY;
+        const uint32_t dayStart = (day + i) * SECONDS_PER_DAY;
+        const uint32_t windowOpen =
+            dayStart + ((uint32_t)job->windowStart * SECONDS_PER_MINUTE);
+        const uint32_t windowClose =
+            dayStart + ((uint32_t)job->windowEnd * SECONDS_PER_MINUTE);
+
+        if(((job->weekdays & SCHEDULER_WEEKDAY(weekday)) != 0U) &&
+           (time < windowClose))
+        {
+            opening = (time > windowOpen) ? time : windowOpen;
+            break;
+        }
+    }
+
+    return opening;
 }
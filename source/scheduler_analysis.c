@@ -0,0 +1,738 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_analysis.c
+ * @brief   This file contains the analysis functions of the scheduler that
+ *          evaluate the configured jobs.
+ *
+ * The analysis functions only read the job table, thus they can also be used
+ * on the host to compare scheduler configurations before deployment. They are
+ * not part of the processing path of the scheduler. The admission control adds
+ * a job only if the analysis of the resulting configuration succeeds.
+ *
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler.h"
+
+/* Private defines -----------------------------------------------------------*/
+/** Number of parts per million of a whole */
+#define PPM 1000000U
+/** Number of milliseconds of a second */
+#define MS_PER_SECOND 1000U
+
+/* Private function prototypes -----------------------------------------------*/
+uint8_t SchedulerAnalysis_IsPeriodic(const Scheduler_t* const sched,
+                                     const uint_fast16_t index);
+uint8_t SchedulerAnalysis_IsTableJob(const Scheduler_t* const sched,
+                                     const uint_fast16_t index);
+uint32_t SchedulerAnalysis_GetSpan(const Scheduler_t* const sched,
+                                   const uint_fast16_t index);
+uint64_t SchedulerAnalysis_GetExecutions(const Scheduler_t* const sched,
+                                         const uint_fast16_t index,
+                                         const uint64_t span);
+uint32_t SchedulerAnalysis_GetPhase(const Scheduler_t* const sched,
+                                    const uint_fast16_t index);
+uint64_t SchedulerAnalysis_GetNextDeadline(const Scheduler_t* const sched,
+                                           const uint64_t cursor,
+                                           const uint64_t limit);
+uint32_t SchedulerAnalysis_CountDeadlines(const Scheduler_t* const sched,
+                                          const uint64_t hyperperiod);
+uint64_t SchedulerAnalysis_Gcd(uint64_t a, uint64_t b);
+uint16_t SchedulerAnalysis_GetRoot(const Scheduler_t* const sched,
+                                   const uint_fast16_t index);
+uint64_t SchedulerAnalysis_GetTableWakeup(const Scheduler_t* const sched,
+                                          const uint32_t after);
+
+/**
+ * @brief  Calculate the hyperperiod of the jobs and the number of wakeups per
+ *         hyperperiod.
+ *
+ * The hyperperiod is the least common multiple of the periods of the jobs,
+ * after which the schedule repeats itself. The wakeups are the distinct nominal
+ * deadlines of the jobs within one hyperperiod, based on the phases of the
+ * scheduled jobs. The jobs that have not been scheduled yet are assumed to be
+ * aligned to a multiple of their period, as in the harmonic registration mode.
+ * The slack and the active windows of the jobs are not taken into account,
+ * thus the number of wakeups is an upper bound. One-shot jobs are ignored. In
+ * the table-driven mode, the hyperperiod of the static schedule and its wakeup
+ * entries are included.
+ *
+ * The wakeups are enumerated up to ::SCHEDULER_ANALYSIS_MAX_WAKEUPS. Beyond
+ * the limit, the deadlines of each job are counted as separate wakeups, i.e.
+ * the number of wakeups is the sum of the executions of the jobs per
+ * hyperperiod, which is larger than the limit.
+ *
+ * @note  The cost of the function is proportional to the number of wakeups
+ *        per hyperperiod, at most ::SCHEDULER_ANALYSIS_MAX_WAKEUPS, multiplied
+ *        by the number of jobs. For an exact result, the function should be
+ *        called while the scheduler is stopped.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param hyperperiod  Pointer where the hyperperiod in [s] is written.
+ * @param wakeups      Pointer where the number of wakeups per hyperperiod is
+ *                     written.
+ * @return  A non-zero value if the hyperperiod has been calculated; otherwise
+ *          zero, i.e. there are no jobs or the hyperperiod exceeds 32 bits.
+ */
+uint8_t SchedulerGetHyperperiod(const Scheduler_t* const sched,
+                                uint32_t* const hyperperiod,
+                                uint32_t* const wakeups)
+{
+    uint8_t result = 1U;
+    uint64_t lcm   = 0U;
+
+    if(sched->table != NULL)
+    {
+        /* The static schedule repeats itself after its hyperperiod */
+        lcm = sched->table->hyperperiod;
+    }
+    else
+    {
+        /* No static schedule */
+    }
+
+    /* Calculate the least common multiple of the periods */
+    for(uint_fast16_t i = 0U; (i < sched->capacity) && (result != 0U); ++i)
+    {
+        if(SchedulerAnalysis_IsPeriodic(sched, i) != 0U)
+        {
+            const uint64_t period = sched->jobs[i].period;
+            if(lcm == 0U)
+            {
+                lcm = period;
+            }
+            else
+            {
+                lcm = (lcm / SchedulerAnalysis_Gcd(lcm, period)) * period;
+            }
+
+            if(lcm > 0xFFFFFFFFU)
+            {
+                /* Hyperperiod is out of range */
+                result = 0U;
+            }
+        }
+    }
+
+    if((result != 0U) && (lcm != 0U))
+    {
+        uint32_t count  = 0U;
+        uint64_t cursor = 0U;
+
+        /* Step through the distinct deadlines within one hyperperiod, up to
+         * the limit of the enumeration */
+        while(count <= SCHEDULER_ANALYSIS_MAX_WAKEUPS)
+        {
+            const uint64_t next =
+                SchedulerAnalysis_GetNextDeadline(sched, cursor, lcm);
+            if(next >= lcm)
+            {
+                break;
+            }
+
+            ++count;
+            cursor = next + 1U;
+        }
+
+        if(count > SCHEDULER_ANALYSIS_MAX_WAKEUPS)
+        {
+            /* Too many wakeups to enumerate: count the deadlines of each job
+             * as a separate wakeup, which is an upper bound */
+            count = SchedulerAnalysis_CountDeadlines(sched, lcm);
+        }
+        else
+        {
+            /* All distinct deadlines have been counted */
+        }
+
+        *hyperperiod = (uint32_t)lcm;
+        *wakeups     = count;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Analyze the schedulability and the energy consumption of the jobs.
+ *
+ * The analysis is based on the declared worst-case execution times of the jobs,
+ * see ::SchedulerSetJobWcet(). Each execution of a periodic, calendar or table
+ * job costs its execution time plus the execution times of its triggered jobs,
+ * and each wakeup costs the wakeup time of the budget. The worst-case awake
+ * time per hyperperiod is the sum of these costs, which gives the utilization
+ * of the CPU and the average current consumption with the power model of the
+ * budget. If the hyperperiod exceeds 32 bits, or the wakeups per hyperperiod
+ * exceed ::SCHEDULER_ANALYSIS_MAX_WAKEUPS, each execution is assumed to need
+ * its own wakeup, which is an upper bound.
+ *
+ * The function only reads the job table, thus it can be used on the host to
+ * check a configuration offline, as well as on the target before adding jobs.
+ * One-shot jobs are ignored.
+ *
+ * @note  The cost of the function is dominated by the calculation of the
+ *        hyperperiod, see ::SchedulerGetHyperperiod().
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param budget    Pointer to the limits and the power model.
+ * @param analysis  Pointer where the result of the analysis is written.
+ * @return  Zero if the jobs fit into the budget; otherwise a combination of the
+ *          ::SCHEDULER_ANALYSIS_OVERLOAD and ::SCHEDULER_ANALYSIS_ENERGY flags.
+ *          The ::SCHEDULER_ANALYSIS_ESTIMATED flag is set if the hyperperiod is
+ *          out of range or the wakeups have not been enumerated.
+ */
+uint8_t SchedulerAnalyze(const Scheduler_t* const sched,
+                         const SchedulerBudget_t* const budget,
+                         SchedulerAnalysis_t* const analysis)
+{
+    uint8_t result       = 0U;
+    uint64_t utilization = 0U;
+
+    assert_param(budget != NULL);
+    assert_param(analysis != NULL);
+
+    analysis->hyperperiod = 0U;
+    analysis->wakeups     = 0U;
+    analysis->awakeTime   = 0U;
+
+    if(SchedulerGetHyperperiod(
+           sched, &analysis->hyperperiod, &analysis->wakeups) != 0U)
+    {
+        /* Sum the executions within one hyperperiod */
+        const uint64_t hyperperiod = analysis->hyperperiod;
+        if(analysis->wakeups > SCHEDULER_ANALYSIS_MAX_WAKEUPS)
+        {
+            /* The wakeups have not been enumerated */
+            result = SCHEDULER_ANALYSIS_ESTIMATED;
+        }
+        analysis->awakeTime = (uint64_t)analysis->wakeups * budget->wakeupTime;
+
+        for(uint_fast16_t i = 0U; i < sched->capacity; ++i)
+        {
+            const uint16_t root = SchedulerAnalysis_GetRoot(sched, i);
+            if(root != SCHEDULER_NO_JOB)
+            {
+                analysis->awakeTime +=
+                    (uint64_t)sched->jobData[i].wcet *
+                    SchedulerAnalysis_GetExecutions(sched, root, hyperperiod);
+            }
+        }
+
+        utilization =
+            (analysis->awakeTime * (PPM / MS_PER_SECOND)) / hyperperiod;
+    }
+    else
+    {
+        /* Assume a separate wakeup for each execution, and for each wakeup
+         * entry of the static schedule */
+        if(sched->table != NULL)
+        {
+            utilization += ((uint64_t)sched->table->count * budget->wakeupTime *
+                            (PPM / MS_PER_SECOND)) /
+                           sched->table->hyperperiod;
+            result = SCHEDULER_ANALYSIS_ESTIMATED;
+        }
+
+        for(uint_fast16_t i = 0U; i < sched->capacity; ++i)
+        {
+            const uint16_t root = SchedulerAnalysis_GetRoot(sched, i);
+            if(root != SCHEDULER_NO_JOB)
+            {
+                const uint64_t span = SchedulerAnalysis_GetSpan(sched, root);
+                uint64_t cost       = sched->jobData[i].wcet;
+                if((root == i) &&
+                   (SchedulerAnalysis_IsPeriodic(sched, i) != 0U))
+                {
+                    cost += budget->wakeupTime;
+                }
+                utilization +=
+                    (cost * SchedulerAnalysis_GetExecutions(sched, root, span) *
+                     (PPM / MS_PER_SECOND)) /
+                    span;
+                result = SCHEDULER_ANALYSIS_ESTIMATED;
+            }
+        }
+    }
+
+    /* Check the utilization of the CPU */
+    if((utilization > PPM) ||
+       ((budget->maxUtilization != 0U) &&
+        (utilization > budget->maxUtilization)))
+    {
+        result |= SCHEDULER_ANALYSIS_OVERLOAD;
+    }
+    analysis->utilization = (utilization < PPM) ? (uint32_t)utilization : PPM;
+
+    /* Check the average current consumption */
+    analysis->averageCurrent = (uint32_t)(
+        (((uint64_t)budget->activeCurrent * MS_PER_SECOND *
+          analysis->utilization) +
+         ((uint64_t)budget->sleepCurrent * (PPM - analysis->utilization))) /
+        PPM);
+    if((budget->maxAverageCurrent != 0U) &&
+       (analysis->averageCurrent > budget->maxAverageCurrent))
+    {
+        result |= SCHEDULER_ANALYSIS_ENERGY;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Add a new job to the scheduler if the jobs still fit into a budget
+ *         with the job.
+ *
+ * The job is added with its declared worst-case execution time, then the jobs
+ * are analyzed with ::SchedulerAnalyze(). If the analysis reports an overload
+ * or an exceeded energy budget, the job is cancelled before it is scheduled.
+ *
+ * @note  The function is meant to be called from tasks upon configuring the
+ *        jobs, since the cost of the analysis grows with the number of jobs
+ *        multiplied by ::SCHEDULER_ANALYSIS_MAX_WAKEUPS, see
+ *        ::SchedulerGetHyperperiod().
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param budget    Pointer to the limits and the power model.
+ * @param period    The period in [s] which the job needs to be executed, up to
+ *                  ::SCHEDULER_MAX_PERIOD.
+ * @param wcet      The worst-case execution time in [ms] of the callback.
+ * @param callback  The callback function that is called upon job execution.
+ * @param context   The context passed to the callback function.
+ * @return  The handle of the job if the job has been admitted; otherwise
+ *          ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAdmitJob(Scheduler_t* const sched,
+                              const SchedulerBudget_t* const budget,
+                              const uint32_t period,
+                              const uint16_t wcet,
+                              const Callback_t callback,
+                              void* const context)
+{
+    SchedulerAnalysis_t analysis;
+    JobHandle_t handle = SchedulerAddJob(sched, period, callback, context);
+
+    if(handle != SCHEDULER_INVALID_HANDLE)
+    {
+        SchedulerSetJobWcet(sched, handle, wcet);
+
+        if((SchedulerAnalyze(sched, budget, &analysis) &
+            (SCHEDULER_ANALYSIS_OVERLOAD | SCHEDULER_ANALYSIS_ENERGY)) != 0U)
+        {
+            SchedulerCancelJob(sched, handle);
+            handle = SCHEDULER_INVALID_HANDLE;
+        }
+    }
+
+    return handle;
+}
+
+/**
+ * @brief  Get the earliest wakeup of the scheduler after a given time.
+ *
+ * The wakeups are predicted from the current deadlines of the scheduled jobs
+ * and the multiples of their periods, without modifying the scheduler. The
+ * next N wakeups can be iterated by calling the function repeatedly with the
+ * previously returned wakeup. Paused jobs, triggered jobs and jobs that are
+ * being cancelled do not cause wakeups. The wakeup entries of the static
+ * schedule are included in the table-driven mode. The pending requests, the
+ * active windows and the stretching of the periods by the wakeup budget
+ * governor are not taken into account beyond the current deadlines.
+ *
+ * @note  The function may be called from tasks while the scheduler is running.
+ *        A processing step in the meantime may move the deadlines, in which
+ *        case the prediction is outdated by at most that processing step.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param after   The time (Unix epoch) after which the wakeup is searched.
+ * @param wakeup  Pointer where the time (Unix epoch) of the wakeup is written.
+ * @return  A non-zero value if a wakeup has been found; otherwise zero, i.e.
+ *          the scheduler is stopped or has no jobs to be scheduled.
+ */
+uint8_t SchedulerGetNextWakeup(const Scheduler_t* const sched,
+                               const uint32_t after,
+                               uint32_t* const wakeup)
+{
+    uint8_t result = 0U;
+    uint64_t next  = 0U;
+
+    assert_param(sched != NULL);
+    assert_param(wakeup != NULL);
+
+    /* The deadlines are relative to the reference time while stopped */
+    const uint_fast16_t count = (sched->isRunning != 0U) ? sched->capacity : 0U;
+
+    for(uint_fast16_t i = 0U; i < count; ++i)
+    {
+        const Job_t* const job = &sched->jobs[i];
+
+        if(((sched->allocated[i / 32U] & (1UL << (i % 32U))) != 0U) &&
+           (job->isActive != 0U) && (job->isPaused == 0U) &&
+           (job->type != SCHEDULER_JOB_TRIGGERED) &&
+           (job->request != (((uint32_t)job->generation << 16U) |
+                             SCHEDULER_REQUEST_CANCEL)))
+        {
+            const uint64_t period = job->period;
+            uint64_t deadline     = job->deadline;
+
+            if((deadline <= after) && (period != 0U))
+            {
+                /* Skip the executions up to the given time */
+                deadline += (((after - deadline) / period) + 1U) * period;
+            }
+
+            if((deadline > after) && (deadline <= 0xFFFFFFFFU) &&
+               ((result == 0U) || (deadline < next)))
+            {
+                next   = deadline;
+                result = 1U;
+            }
+        }
+    }
+
+    if((sched->isRunning != 0U) && (sched->table != NULL))
+    {
+        const uint64_t tableWakeup =
+            SchedulerAnalysis_GetTableWakeup(sched, after);
+        if((tableWakeup <= 0xFFFFFFFFU) &&
+           ((result == 0U) || (tableWakeup < next)))
+        {
+            next   = tableWakeup;
+            result = 1U;
+        }
+    }
+
+    if(result != 0U)
+    {
+        *wakeup = (uint32_t)next;
+    }
+    else
+    {
+        /* No wakeup: leave the output unchanged */
+    }
+
+    return result;
+}
+
+/**
+ * @brief  This function checks whether a job slot is allocated to a job that
+ *         has a period, i.e. to a job that is neither a one-shot job, nor a
+ *         triggered job, nor a job that is being cancelled.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ * @return  A non-zero value if the job slot is allocated to a job with a
+ *          period; otherwise zero.
+ */
+uint8_t SchedulerAnalysis_IsPeriodic(const Scheduler_t* const sched,
+                                     const uint_fast16_t index)
+{
+    const Job_t* const job = &sched->jobs[index];
+
+    /* A job with a pending cancel request is released at the next processing
+     * step, e.g. a job rejected by the admission control */
+    return (((sched->allocated[index / 32U] & (1UL << (index % 32U))) != 0U) &&
+            (job->period != 0U) &&
+            (job->request != (((uint32_t)job->generation << 16U) |
+                              SCHEDULER_REQUEST_CANCEL)))
+               ? 1U
+               : 0U;
+}
+
+/**
+ * @brief  This function checks whether a job slot is allocated to a table job
+ *         that is made pending by the static schedule, i.e. to a table job
+ *         within the range of the pending masks that is not being cancelled.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ * @return  A non-zero value if the job slot is allocated to a table job of the
+ *          static schedule; otherwise zero.
+ */
+uint8_t SchedulerAnalysis_IsTableJob(const Scheduler_t* const sched,
+                                     const uint_fast16_t index)
+{
+    const Job_t* const job = &sched->jobs[index];
+
+    return ((sched->table != NULL) && (index < SCHEDULER_TABLE_MAX_JOBS) &&
+            ((sched->allocated[index / 32U] & (1UL << (index % 32U))) != 0U) &&
+            (job->type == SCHEDULER_JOB_TABLE) &&
+            (job->request != (((uint32_t)job->generation << 16U) |
+                              SCHEDULER_REQUEST_CANCEL)))
+               ? 1U
+               : 0U;
+}
+
+/**
+ * @brief  This function returns the time after which the executions of a job
+ *         repeat themselves, i.e. the period of a periodic job or the
+ *         hyperperiod of the static schedule for a table job.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of a periodic job or of a table job.
+ * @return  The time span in [s].
+ */
+uint32_t SchedulerAnalysis_GetSpan(const Scheduler_t* const sched,
+                                   const uint_fast16_t index)
+{
+    return (sched->jobs[index].type == SCHEDULER_JOB_TABLE)
+               ? sched->table->hyperperiod
+               : sched->jobs[index].period;
+}
+
+/**
+ * @brief  This function returns the number of executions of a job within a
+ *         time span that is a multiple of the span of the job, see
+ *         ::SchedulerAnalysis_GetSpan().
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of a periodic job or of a table job.
+ * @param span   The time span in [s].
+ * @return  The number of executions.
+ */
+uint64_t SchedulerAnalysis_GetExecutions(const Scheduler_t* const sched,
+                                         const uint_fast16_t index,
+                                         const uint64_t span)
+{
+    uint64_t executions = 0U;
+
+    if(sched->jobs[index].type == SCHEDULER_JOB_TABLE)
+    {
+        /* Count the wakeup entries whose pending mask contains the job */
+        const SchedulerTable_t* const table = sched->table;
+        for(uint_fast16_t position = 0U; position < table->count; ++position)
+        {
+            if((table->entries[position].pending & (1UL << index)) != 0U)
+            {
+                ++executions;
+            }
+        }
+        executions *= span / table->hyperperiod;
+    }
+    else
+    {
+        executions = span / sched->jobs[index].period;
+    }
+
+    return executions;
+}
+
+/**
+ * @brief  This function returns the phase of a job, i.e. the offset of its
+ *         nominal deadlines from the multiples of its period.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ * @return  The phase in [s] of the job.
+ */
+uint32_t SchedulerAnalysis_GetPhase(const Scheduler_t* const sched,
+                                    const uint_fast16_t index)
+{
+    const Job_t* const job = &sched->jobs[index];
+    uint32_t phase         = 0U;
+
+    if(job->isActive != 0U)
+    {
+        phase = (job->deadline - job->slack) % job->period;
+    }
+    else
+    {
+        /* Job has not been scheduled yet: assume alignment */
+        phase = 0U;
+    }
+
+    return phase;
+}
+
+/**
+ * @brief  This function returns the earliest nominal deadline of the jobs that
+ *         is not earlier than a given time.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param cursor  The time in [s] relative to the multiples of the hyperperiod.
+ * @param limit   The value returned if no deadline is earlier than the limit.
+ * @return  The earliest deadline, or the limit.
+ */
+uint64_t SchedulerAnalysis_GetNextDeadline(const Scheduler_t* const sched,
+                                           const uint64_t cursor,
+                                           const uint64_t limit)
+{
+    uint64_t next = limit;
+
+    for(uint_fast16_t i = 0U; i < sched->capacity; ++i)
+    {
+        if(SchedulerAnalysis_IsPeriodic(sched, i) != 0U)
+        {
+            const uint64_t period = sched->jobs[i].period;
+            const uint64_t phase  = SchedulerAnalysis_GetPhase(sched, i);
+            const uint64_t deadline =
+                cursor + (((phase + period) - (cursor % period)) % period);
+            if(deadline < next)
+            {
+                next = deadline;
+            }
+        }
+    }
+
+    if(sched->table != NULL)
+    {
+        const SchedulerTable_t* const table = sched->table;
+        const uint64_t hyperperiod          = table->hyperperiod;
+
+        /* The wakeup entries of the static schedule, relative to the start of
+         * its current cycle */
+        const uint64_t phase = sched->tableCycleStart % hyperperiod;
+        const uint64_t elapsed =
+            ((cursor % hyperperiod) + hyperperiod - phase) % hyperperiod;
+
+        for(uint_fast16_t position = 0U; position < table->count; ++position)
+        {
+            const uint64_t offset =
+                table->entries[position].offset % hyperperiod;
+            const uint64_t deadline =
+                cursor + (((offset + hyperperiod) - elapsed) % hyperperiod);
+            if(deadline < next)
+            {
+                next = deadline;
+            }
+        }
+    }
+    else
+    {
+        /* No static schedule */
+    }
+
+    return next;
+}
+
+/**
+ * @brief  This function counts the nominal deadlines of the jobs within one
+ *         hyperperiod, where the coinciding deadlines of different jobs are
+ *         counted separately.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param hyperperiod  The hyperperiod in [s] of the jobs.
+ * @return  The number of deadlines, saturated at the hyperperiod, i.e. at one
+ *          deadline per second.
+ */
+uint32_t SchedulerAnalysis_CountDeadlines(const Scheduler_t* const sched,
+                                          const uint64_t hyperperiod)
+{
+    uint64_t count = 0U;
+
+    if(sched->table != NULL)
+    {
+        count = (hyperperiod / sched->table->hyperperiod) * sched->table->count;
+    }
+
+    for(uint_fast16_t i = 0U; i < sched->capacity; ++i)
+    {
+        if(SchedulerAnalysis_IsPeriodic(sched, i) != 0U)
+        {
+            count += hyperperiod / sched->jobs[i].period;
+        }
+    }
+
+    return (uint32_t)((count < hyperperiod) ? count : hyperperiod);
+}
+
+/**
+ * @brief  This function returns the periodic job or the table job whose
+ *         executions trigger the execution of a job, following the
+ *         predecessors of triggered jobs.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of an allocated job.
+ * @return  The index of the periodic job or the table job, i.e. the index of
+ *          the job itself if it is periodic or a table job; otherwise
+ *          ::SCHEDULER_NO_JOB.
+ */
+uint16_t SchedulerAnalysis_GetRoot(const Scheduler_t* const sched,
+                                   const uint_fast16_t index)
+{
+    uint16_t current = (uint16_t)index;
+
+    /* The predecessors form a tree, thus the walk ends at its root */
+    while((current != SCHEDULER_NO_JOB) &&
+          (sched->jobs[current].type == SCHEDULER_JOB_TRIGGERED))
+    {
+        current = sched->jobData[current].predecessor;
+    }
+
+    return ((current != SCHEDULER_NO_JOB) &&
+            ((SchedulerAnalysis_IsPeriodic(sched, current) != 0U) ||
+             (SchedulerAnalysis_IsTableJob(sched, current) != 0U)))
+               ? current
+               : SCHEDULER_NO_JOB;
+}
+
+/**
+ * @brief  This function returns the earliest wakeup entry of the static
+ *         schedule after a given time.
+ *
+ * @param sched  Pointer to the scheduler in the table-driven mode.
+ * @param after  The time (Unix epoch) after which the wakeup is searched.
+ * @return  The time (Unix epoch) of the wakeup.
+ */
+uint64_t SchedulerAnalysis_GetTableWakeup(const Scheduler_t* const sched,
+                                          const uint32_t after)
+{
+    const SchedulerTable_t* const table = sched->table;
+    uint64_t wakeup =
+        (uint64_t)sched->tableCycleStart +
+        table->entries[sched->tablePosition].offset;
+
+    if(wakeup <= after)
+    {
+        /* The entries before the position have been reached, thus the wakeup
+         * is searched from the hyperperiod that contains the given time */
+        const uint64_t hyperperiod = table->hyperperiod;
+        uint64_t cycleStart        = sched->tableCycleStart;
+        cycleStart += ((after - cycleStart) / hyperperiod) * hyperperiod;
+
+        uint_fast16_t position = 0U;
+        while((position < table->count) &&
+              ((cycleStart + table->entries[position].offset) <= after))
+        {
+            ++position;
+        }
+
+        if(position == table->count)
+        {
+            cycleStart += hyperperiod;
+            position = 0U;
+        }
+
+        wakeup = cycleStart + table->entries[position].offset;
+    }
+
+    return wakeup;
+}
+
+/**
+ * @brief  This function calculates the greatest common divisor of two numbers.
+ *
+ * @param a  The first number.
+ * @param b  The second number.
+ * @return  The greatest common divisor.
+ */
+uint64_t SchedulerAnalysis_Gcd(uint64_t a, uint64_t b)
+{
+    while(b != 0U)
+    {
+        const uint64_t remainder = a % b;
+        a                        = b;
+        b                        = remainder;
+    }
+
+    return a;
+}
@@ -0,0 +1,232 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_heap.c
+ * @brief   This file contains the binary min-heap queue backend of the
+ *          scheduler.
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler_queue.h"
+
+#if(SCHEDULER_QUEUE == SCHEDULER_QUEUE_HEAP)
+
+/* Private defines -----------------------------------------------------------*/
+/** The index of the job at a given position of the heap. The heap array is
+ * spread over the links of the job table, thus it needs no separate storage. */
+#define HEAP_ENTRY(sched, position) ((sched)->jobs[(position)].link.entry)
+
+/* Private function prototypes -----------------------------------------------*/
+void SchedulerHeap_Place(Scheduler_t* const sched,
+                         const uint_fast16_t position,
+                         const uint16_t index);
+void SchedulerHeap_SiftUp(Scheduler_t* const sched, uint_fast16_t position);
+void SchedulerHeap_SiftDown(Scheduler_t* const sched, uint_fast16_t position);
+
+/**
+ * @brief  Initialize the queue by removing all jobs from the heap.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch). Not used by the heap.
+ */
+void SchedulerQueueInit(Scheduler_t* const sched, const uint32_t currentTime)
+{
+    UNUSED(currentTime);
+
+    sched->queue.size = 0U;
+}
+
+/**
+ * @brief  Insert a job into the heap according to its deadline in O(log n).
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void SchedulerQueueInsert(Scheduler_t* const sched, const uint16_t index)
+{
+    assert_param(sched->queue.size < sched->capacity);
+
+    const uint_fast16_t position = sched->queue.size;
+    ++sched->queue.size;
+
+    SchedulerHeap_Place(sched, position, index);
+    SchedulerHeap_SiftUp(sched, position);
+}
+
+/**
+ * @brief  Remove a job from the heap in O(log n).
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void SchedulerQueueRemove(Scheduler_t* const sched, const uint16_t index)
+{
+    const uint_fast16_t position = sched->jobs[index].link.position;
+
+    assert_param(position < sched->queue.size);
+    assert_param(HEAP_ENTRY(sched, position) == index);
+
+    --sched->queue.size;
+    if(position < sched->queue.size)
+    {
+        /* Move the last entry into the freed position and restore the order */
+        const uint16_t lastIndex = HEAP_ENTRY(sched, sched->queue.size);
+        SchedulerHeap_Place(sched, position, lastIndex);
+        SchedulerHeap_SiftUp(sched, position);
+        SchedulerHeap_SiftDown(sched, sched->jobs[lastIndex].link.position);
+    }
+}
+
+/**
+ * @brief  Get the job with the earliest deadline of the heap in O(1).
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  Pointer where the index of the job with the earliest deadline
+ *               is written.
+ * @return  A non-zero value if the heap is not empty; otherwise zero.
+ */
+uint8_t SchedulerQueuePeek(Scheduler_t* const sched, uint16_t* const index)
+{
+    uint8_t result = 0U;
+
+    if(sched->queue.size > 0U)
+    {
+        *index = HEAP_ENTRY(sched, 0U);
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Remove the job with the earliest deadline from the heap if it is due.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ * @param index        Pointer where the index of the due job is written.
+ * @return  A non-zero value if a due job has been removed; otherwise zero.
+ */
+uint8_t SchedulerQueuePopDue(Scheduler_t* const sched,
+                             const uint32_t currentTime,
+                             uint16_t* const index)
+{
+    uint8_t result = 0U;
+
+    if((sched->queue.size > 0U) &&
+       (sched->jobs[HEAP_ENTRY(sched, 0U)].deadline <= currentTime))
+    {
+        *index = HEAP_ENTRY(sched, 0U);
+
+        --sched->queue.size;
+        if(sched->queue.size > 0U)
+        {
+            SchedulerHeap_Place(
+                sched, 0U, HEAP_ENTRY(sched, sched->queue.size));
+            SchedulerHeap_SiftDown(sched, 0U);
+        }
+
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  This function places a job at a given position of the heap.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param position  The position in the heap.
+ * @param index     The index of the job.
+ */
+void SchedulerHeap_Place(Scheduler_t* const sched,
+                         const uint_fast16_t position,
+                         const uint16_t index)
+{
+    HEAP_ENTRY(sched, position)      = index;
+    sched->jobs[index].link.position = (uint16_t)position;
+}
+
+/**
+ * @brief  This function moves a heap entry towards the root of the heap until
+ *         the deadline of its parent is not later than its own deadline.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param position  The position of the entry in the heap.
+ */
+void SchedulerHeap_SiftUp(Scheduler_t* const sched, uint_fast16_t position)
+{
+    const uint16_t index    = HEAP_ENTRY(sched, position);
+    const uint32_t deadline = sched->jobs[index].deadline;
+
+    while(position > 0U)
+    {
+        const uint_fast16_t parent = (position - 1U) / 2U;
+        const uint16_t parentIndex = HEAP_ENTRY(sched, parent);
+        if(sched->jobs[parentIndex].deadline <= deadline)
+        {
+            break;
+        }
+
+        SchedulerHeap_Place(sched, position, parentIndex);
+        position = parent;
+    }
+
+    SchedulerHeap_Place(sched, position, index);
+}
+
+/**
+ * @brief  This function moves a heap entry towards the leaves of the heap until
+ *         the deadlines of its children are not earlier than its own deadline.
+ *
+ * @param sched     Pointer to the scheduler.
+ * @param position  The position of the entry in the heap.
+ */
+void SchedulerHeap_SiftDown(Scheduler_t* const sched, uint_fast16_t position)
+{
+    const uint16_t index    = HEAP_ENTRY(sched, position);
+    const uint32_t deadline = sched->jobs[index].deadline;
+
+    for(;;)
+    {
+        uint_fast16_t child = (2U * position) + 1U;
+        if(child >= sched->queue.size)
+        {
+            break;
+        }
+
+        /* Select the child with the earlier deadline */
+        if(((child + 1U) < sched->queue.size) &&
+           (sched->jobs[HEAP_ENTRY(sched, child + 1U)].deadline <
+            sched->jobs[HEAP_ENTRY(sched, child)].deadline))
+        {
+            ++child;
+        }
+
+        const uint16_t childIndex = HEAP_ENTRY(sched, child);
+        if(deadline <= sched->jobs[childIndex].deadline)
+        {
+            break;
+        }
+
+        SchedulerHeap_Place(sched, position, childIndex);
+        position = child;
+    }
+
+    SchedulerHeap_Place(sched, position, index);
+}
+
+#endif /* SCHEDULER_QUEUE_HEAP */
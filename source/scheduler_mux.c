@@ -0,0 +1,296 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_mux.c
+ * @brief   This file contains the RTC alarm multiplexer of the scheduler
+ *          instances.
+ *
+ * The scheduler instances share the single RTC alarm of the MCU. Upon each
+ * wakeup, the multiplexer processes every attached instance with the same
+ * current time, then configures the RTC alarm once for the earliest deadline
+ * of all instances. The RTC alarm is only re-programmed if the earliest
+ * deadline has changed.
+ *
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler_mux.h"
+#include "rtc.h"
+
+/* Private variables ---------------------------------------------------------*/
+/** The first scheduler instance attached to the multiplexer */
+static Scheduler_t* volatile instances = NULL;
+
+/** The time (Unix epoch) of the currently configured RTC alarm */
+static volatile uint32_t alarmTime = 0U;
+
+/** The number of times the RTC alarm could not be configured */
+static volatile uint32_t alarmErrors = 0U;
+
+/**
+ * @brief  Initialize the multiplexer by detaching all scheduler instances.
+ */
+void SchedulerMuxInit(void)
+{
+    instances   = NULL;
+    alarmTime   = 0U;
+    alarmErrors = 0U;
+}
+
+/**
+ * @brief  Attach a scheduler instance to the multiplexer.
+ *
+ * @note  The instance must be initialized before it is attached. An instance
+ *        must not be attached more than once.
+ *
+ * @param sched  Pointer to the scheduler.
+ */
+void SchedulerMuxAttach(Scheduler_t* const sched)
+{
+    assert_param(sched != NULL);
+
+    /* Publish the instance after it has been linked */
+    sched->next = instances;
+    __DMB();
+    instances = sched;
+}
+
+/**
+ * @brief  Process the attached scheduler instances.
+ *
+ * This function needs to be called each time upon an RTC alarm interrupt. Each
+ * instance is processed, then the RTC alarm is configured for the job that
+ * needs to be executed the earliest among all instances. If no instance has a
+ * job to be scheduled, the RTC alarm is deactivated.
+ *
+ * If the deadline passes while the RTC alarm is configured, the instances are
+ * processed again, up to ::SCHEDULER_MUX_ALARM_ATTEMPTS times. If the RTC alarm
+ * cannot be configured at all, e.g. due to a HAL error, the RTC alarm is left
+ * deactivated and the error is counted, see ::SchedulerMuxGetAlarmErrors().
+ *
+ * @note  The function does not automatically execute the callbacks of the
+ *        pending jobs. The pending jobs can be executed by calling the
+ *        ::SchedulerMuxExecutePendingJobs() function, e.g. from a dispatcher
+ *        task that is notified if this function returns a non-zero value.
+ *
+ * @return  A non-zero value if any instance has jobs that are ready for
+ *          execution; otherwise zero.
+ */
+uint8_t SchedulerMuxProcess(void)
+{
+    uint8_t result        = 0U;
+    uint_fast8_t attempts = 0U;
+    uint32_t currentTime  = RtcGetEpoch();
+
+    /* Process the instances until the RTC alarm is set for the job that needs
+     * to be executed the earliest */
+    for(;;)
+    {
+        uint8_t hasDeadline   = 0U;
+        uint32_t nextDeadline = 0U;
+
+        for(Scheduler_t* sched = instances; sched != NULL; sched = sched->next)
+        {
+            uint32_t deadline = 0U;
+            if((SchedulerProcess(sched, currentTime, &deadline) != 0U) &&
+               ((hasDeadline == 0U) || (deadline < nextDeadline)))
+            {
+                nextDeadline = deadline;
+                hasDeadline  = 1U;
+            }
+        }
+
+        if(hasDeadline == 0U)
+        {
+            /* There are no jobs to be scheduled */
+            if(alarmTime != 0U)
+            {
+                RtcDeactivateAlarm();
+                alarmTime = 0U;
+            }
+            break;
+        }
+        else if(nextDeadline == alarmTime)
+        {
+            /* The RTC alarm is already configured for the next job */
+            break;
+        }
+        else if(RtcSetAlarmFromEpoch(nextDeadline) != 0U)
+        {
+            alarmTime = nextDeadline;
+            break;
+        }
+        else if((attempts + 1U) >= SCHEDULER_MUX_ALARM_ATTEMPTS)
+        {
+            /* The RTC alarm cannot be configured */
+            RtcDeactivateAlarm();
+            alarmTime = 0U;
+            ++alarmErrors;
+            break;
+        }
+        else
+        {
+            /* The deadline has passed while setting the alarm */
+            currentTime = RtcGetEpoch();
+            ++attempts;
+        }
+    }
+
+    for(Scheduler_t* sched = instances; sched != NULL; sched = sched->next)
+    {
+        if(SchedulerHasPendingJobs(sched) != 0U)
+        {
+            result = 1U;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Execute the pending jobs of the attached scheduler instances.
+ *
+ * @warning  The callbacks of the jobs are executed from the context of the
+ *           caller. See ::SchedulerExecutePendingJobs() for details.
+ */
+void SchedulerMuxExecutePendingJobs(void)
+{
+    for(Scheduler_t* sched = instances; sched != NULL; sched = sched->next)
+    {
+        SchedulerExecutePendingJobs(sched);
+    }
+}
+
+/**
+ * @brief  Take the next notification of the jobs without a callback of the
+ *         attached scheduler instances.
+ *
+ * @note  This function must be called from the context of the processing, see
+ *        ::SchedulerTakeNotification() for details.
+ *
+ * @param context  Pointer where the context of the job is written.
+ * @param count    Pointer where the number of pending executions is written.
+ * @return  A non-zero value if a notification has been taken; otherwise zero.
+ */
+uint8_t SchedulerMuxTakeNotification(void** const context,
+                                     uint8_t* const count)
+{
+    uint8_t result     = 0U;
+    Scheduler_t* sched = instances;
+
+    while((sched != NULL) && (result == 0U))
+    {
+        result = SchedulerTakeNotification(sched, context, count);
+        sched  = sched->next;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Get the remaining time until the configured RTC alarm.
+ *
+ * The RTC alarm is configured for the earliest deadline of all instances, thus
+ * the remaining time is the time until the next wakeup by the scheduler, e.g.
+ * to weigh against the cost of entering into a low-power mode. If the alarm is
+ * already due, the remaining time is zero. The interrupts are masked while the
+ * alarm and the RTC are read.
+ *
+ * @param seconds       Pointer where the whole seconds of the remaining time
+ *                      are written.
+ * @param milliseconds  Pointer where the sub-second part of the remaining time
+ *                      is written in [ms].
+ * @return  A non-zero value if an RTC alarm is configured; otherwise zero.
+ */
+uint8_t SchedulerMuxGetTimeUntilWakeup(uint32_t* const seconds,
+                                       uint16_t* const milliseconds)
+{
+    uint8_t result    = 0U;
+    uint16_t fraction = 0U;
+
+    assert_param(seconds != NULL);
+    assert_param(milliseconds != NULL);
+
+    /* The alarm and the current time are read together, thus the RTC alarm
+     * interrupt cannot move the alarm in between, e.g. from a passed alarm to
+     * the next deadline */
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const uint32_t alarm   = alarmTime;
+    const uint32_t current = RtcGetEpochWithFraction(&fraction);
+    __set_PRIMASK(primask);
+
+    if(alarm == 0U)
+    {
+        /* There are no jobs to be scheduled */
+        result = 0U;
+    }
+    else if(alarm <= current)
+    {
+        *seconds      = 0U;
+        *milliseconds = 0U;
+        result        = 1U;
+    }
+    else if(fraction == 0U)
+    {
+        *seconds      = alarm - current;
+        *milliseconds = 0U;
+        result        = 1U;
+    }
+    else
+    {
+        /* The alarm is set for the beginning of the second of its epoch */
+        *seconds      = alarm - current - 1U;
+        *milliseconds = 1000U - fraction;
+        result        = 1U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Get the earliest wakeup of the attached scheduler instances after a
+ *         given time, see ::SchedulerGetNextWakeup().
+ *
+ * @param after   The time (Unix epoch) after which the wakeup is searched.
+ * @param wakeup  Pointer where the time (Unix epoch) of the wakeup is written.
+ * @return  A non-zero value if a wakeup has been found; otherwise zero.
+ */
+uint8_t SchedulerMuxGetNextWakeup(const uint32_t after, uint32_t* const wakeup)
+{
+    uint8_t result = 0U;
+
+    for(Scheduler_t* sched = instances; sched != NULL; sched = sched->next)
+    {
+        uint32_t next = 0U;
+        if((SchedulerGetNextWakeup(sched, after, &next) != 0U) &&
+           ((result == 0U) || (next < *wakeup)))
+        {
+            *wakeup = next;
+            result  = 1U;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Get the number of times the RTC alarm could not be configured upon
+ *         processing.
+ *
+ * While the RTC alarm is not configured, the scheduler instances are only
+ * processed upon the next request that sets the RTC alarm interrupt pending,
+ * thus the application should treat an error as fatal or retry the processing.
+ *
+ * @return  The number of errors since the initialization of the multiplexer.
+ */
+uint32_t SchedulerMuxGetAlarmErrors(void)
+{
+    return alarmErrors;
+}
@@ -0,0 +1,483 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_packed.c
+ * @brief   This file contains the packed remaining-time queue backend of the
+ *          scheduler.
+ *
+ * The remaining time of each job is kept in a 16-bit lane, two lanes per word.
+ * Upon each wakeup, the lanes are counted down by the elapsed time with the
+ * saturating SIMD subtraction of the Cortex-M4 core (UQSUB16), i.e. two jobs
+ * per instruction, and the due jobs are collected into a bitmask without
+ * branches. The bitmask is built once per wakeup, then the due jobs are removed
+ * from it one by one. The earliest deadline is searched with the SIMD
+ * comparison and selection instructions (USUB16, SEL) only after the job with
+ * the earliest deadline has been removed; otherwise it is kept from the
+ * previous search. The lanes are only scanned up to the highest group of 32
+ * lanes that holds a job of the queue, thus a queue with few jobs in the low
+ * slots does not pay for all lanes. If the compiler does not provide the DSP
+ * extension, e.g. in host builds, portable C functions are used instead.
+ *
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler_queue.h"
+
+#if(SCHEDULER_QUEUE == SCHEDULER_QUEUE_PACKED)
+
+/* Private defines -----------------------------------------------------------*/
+/** Remaining time of a lane whose deadline is out of range of the lane */
+#define PACKED_LANE_FAR 0xFFFFU
+
+/** Number of lanes per word */
+#define PACKED_LANES_PER_WORD 2U
+
+/** Replicate a 16-bit value into both lanes of a word */
+#define PACKED_SPLAT(value) ((uint32_t)(value)*0x00010001U)
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+/** Subtract the lanes of two words, saturating at zero */
+#define PACKED_SUB_SATURATE(a, b) __UQSUB16((a), (b))
+#else
+#define PACKED_SUB_SATURATE(a, b) SchedulerPacked_SubSaturate((a), (b))
+#endif
+
+/** Select the smaller of the lanes of two words */
+#define PACKED_MIN(a, b) SchedulerPacked_Min((a), (b))
+
+/* Private variables ---------------------------------------------------------*/
+/** The lanes of a word that belong to the jobs in the queue, indexed by the
+ * two bits of the jobs in the bitmask of the members */
+static const uint32_t laneMask[4U] = {
+    0x00000000U, 0x0000FFFFU, 0xFFFF0000U, 0xFFFFFFFFU};
+
+/* Private function prototypes -----------------------------------------------*/
+void SchedulerPacked_SetLane(Scheduler_t* const sched, const uint16_t index);
+uint_fast16_t SchedulerPacked_GetGroups(const Scheduler_t* const sched);
+void SchedulerPacked_Advance(Scheduler_t* const sched,
+                             const uint32_t currentTime);
+uint32_t SchedulerPacked_GetDueMask(const Scheduler_t* const sched,
+                                    const uint_fast16_t group);
+uint16_t SchedulerPacked_GetLane(const Scheduler_t* const sched,
+                                 const uint_fast16_t index);
+uint32_t SchedulerPacked_SubSaturate(const uint32_t a, const uint32_t b);
+uint32_t SchedulerPacked_Min(const uint32_t a, const uint32_t b);
+
+/**
+ * @brief  Initialize the queue by removing all jobs from the lanes.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch) the lanes are relative to.
+ */
+void SchedulerQueueInit(Scheduler_t* const sched, const uint32_t currentTime)
+{
+    assert_param(sched->capacity <= SCHEDULER_PACKED_LANES);
+
+    sched->queue.time     = currentTime;
+    sched->queue.earliest = SCHEDULER_NO_JOB;
+
+    for(uint_fast16_t i = 0U; i < (SCHEDULER_PACKED_LANES / 32U); ++i)
+    {
+        sched->queue.members[i] = 0U;
+        sched->queue.far[i]     = 0U;
+        sched->queue.due[i]     = 0U;
+    }
+}
+
+/**
+ * @brief  Insert a job into the queue by setting its lane in O(1).
+ *
+ * The job replaces the job with the earliest deadline that has been found by
+ * the previous search if its deadline is earlier.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void SchedulerQueueInsert(Scheduler_t* const sched, const uint16_t index)
+{
+    const uint16_t earliest = sched->queue.earliest;
+
+    assert_param(index < SCHEDULER_PACKED_LANES);
+
+    SchedulerPacked_SetLane(sched, index);
+    sched->queue.members[index / 32U] |= (1UL << (index % 32U));
+
+    if((earliest != SCHEDULER_NO_JOB) &&
+       ((sched->jobs[index].deadline < sched->jobs[earliest].deadline) ||
+        ((sched->jobs[index].deadline == sched->jobs[earliest].deadline) &&
+         (index < earliest))))
+    {
+        sched->queue.earliest = index;
+    }
+    else
+    {
+        /* The earliest deadline is unchanged or has not been searched yet */
+    }
+}
+
+/**
+ * @brief  Remove a job from the queue in O(1).
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void SchedulerQueueRemove(Scheduler_t* const sched, const uint16_t index)
+{
+    assert_param(index < SCHEDULER_PACKED_LANES);
+
+    sched->queue.members[index / 32U] &= ~(1UL << (index % 32U));
+    sched->queue.far[index / 32U] &= ~(1UL << (index % 32U));
+    sched->queue.due[index / 32U] &= ~(1UL << (index % 32U));
+
+    if(index == sched->queue.earliest)
+    {
+        /* The earliest deadline is searched again upon the next peek */
+        sched->queue.earliest = SCHEDULER_NO_JOB;
+    }
+}
+
+/**
+ * @brief  Get the job with the earliest deadline of the queue, in O(1) if it
+ *         has been found by a previous search; otherwise in O(n).
+ *
+ * The smallest remaining time is searched two lanes at a time, then the job of
+ * that lane with the earliest deadline is selected. The lanes of the jobs that
+ * are not in the queue are masked to the largest remaining time. The job that
+ * has been found is kept until it is removed from the queue.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  Pointer where the index of the job with the earliest deadline
+ *               is written.
+ * @return  A non-zero value if the queue is not empty; otherwise zero.
+ */
+uint8_t SchedulerQueuePeek(Scheduler_t* const sched, uint16_t* const index)
+{
+    const uint_fast16_t groups = SchedulerPacked_GetGroups(sched);
+    uint8_t result             = 0U;
+    uint32_t minimum           = 0xFFFFFFFFU;
+    uint32_t present           = 0U;
+
+    if(sched->queue.earliest != SCHEDULER_NO_JOB)
+    {
+        /* The job has been found by a previous search */
+        *index = sched->queue.earliest;
+        result = 1U;
+    }
+    else
+    {
+        for(uint_fast16_t word = 0U; word < (groups * 16U); ++word)
+        {
+            const uint32_t members =
+                (sched->queue.members[word / 16U] >> ((word % 16U) * 2U)) &
+                0x3U;
+            minimum = PACKED_MIN(minimum,
+                                 sched->queue.lanes[word] | ~laneMask[members]);
+            present |= members;
+        }
+    }
+
+    if((result == 0U) && (present != 0U))
+    {
+        const uint32_t lane = ((minimum & 0xFFFFU) < (minimum >> 16U))
+                                  ? (minimum & 0xFFFFU)
+                                  : (minimum >> 16U);
+
+        /* The lanes of the due and of the far jobs do not order the jobs */
+        for(uint_fast16_t group = 0U; group < groups; ++group)
+        {
+            uint32_t members = sched->queue.members[group];
+
+            for(uint_fast16_t i = group * 32U; members != 0U;
+                ++i, members >>= 1U)
+            {
+                if(((members & 1U) != 0U) &&
+                   (SchedulerPacked_GetLane(sched, i) == lane) &&
+                   ((result == 0U) ||
+                    (sched->jobs[i].deadline < sched->jobs[*index].deadline)))
+                {
+                    *index = (uint16_t)i;
+                    result = 1U;
+                }
+            }
+        }
+
+        sched->queue.earliest = *index;
+    }
+    else
+    {
+        /* The job has been found by a previous search, or the queue is
+         * empty */
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Remove the job with the earliest deadline from the queue if it is
+ *         due.
+ *
+ * The lanes are counted down to the current time upon the first call after a
+ * wakeup, which also builds the bitmask of the due jobs, i.e. of the jobs whose
+ * lanes have reached zero. The due jobs are then taken from the bitmask by
+ * walking its set bits with a count-trailing-zeros instruction, thus the lanes
+ * are not scanned again for each due job.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ * @param index        Pointer where the index of the due job is written.
+ * @return  A non-zero value if a due job has been removed; otherwise zero.
+ */
+uint8_t SchedulerQueuePopDue(Scheduler_t* const sched,
+                             const uint32_t currentTime,
+                             uint16_t* const index)
+{
+    uint8_t result = 0U;
+
+    if(currentTime > sched->queue.time)
+    {
+        SchedulerPacked_Advance(sched, currentTime);
+    }
+
+    for(uint_fast16_t group = 0U; group < (SCHEDULER_PACKED_LANES / 32U);
+        ++group)
+    {
+        uint32_t due = sched->queue.due[group];
+
+        /* Select the due job with the earliest deadline */
+        while(due != 0U)
+        {
+            const uint32_t bit    = __CLZ(__RBIT(due));
+            const uint_fast16_t i = (group * 32U) + bit;
+            due &= ~(1UL << bit);
+
+            if((result == 0U) ||
+               (sched->jobs[i].deadline < sched->jobs[*index].deadline))
+            {
+                *index = (uint16_t)i;
+                result = 1U;
+            }
+        }
+    }
+
+    if(result != 0U)
+    {
+        SchedulerQueueRemove(sched, *index);
+    }
+    else
+    {
+        /* No job is due */
+    }
+
+    return result;
+}
+
+/**
+ * @brief  This function sets the lane of a job to the remaining time until its
+ *         deadline, or marks the job as far if the remaining time is out of
+ *         range of the lane. A job whose deadline has been reached is marked as
+ *         due.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void SchedulerPacked_SetLane(Scheduler_t* const sched, const uint16_t index)
+{
+    const uint32_t deadline = sched->jobs[index].deadline;
+    const uint32_t shift    = (index % PACKED_LANES_PER_WORD) * 16U;
+    uint32_t remaining      = 0U;
+
+    if(deadline > sched->queue.time)
+    {
+        remaining = deadline - sched->queue.time;
+    }
+
+    if(remaining >= PACKED_LANE_FAR)
+    {
+        remaining = PACKED_LANE_FAR;
+        sched->queue.far[index / 32U] |= (1UL << (index % 32U));
+    }
+    else
+    {
+        sched->queue.far[index / 32U] &= ~(1UL << (index % 32U));
+    }
+
+    if(remaining == 0U)
+    {
+        sched->queue.due[index / 32U] |= (1UL << (index % 32U));
+    }
+    else
+    {
+        sched->queue.due[index / 32U] &= ~(1UL << (index % 32U));
+    }
+
+    sched->queue.lanes[index / PACKED_LANES_PER_WORD] =
+        (sched->queue.lanes[index / PACKED_LANES_PER_WORD] &
+         ~(0xFFFFUL << shift)) |
+        (remaining << shift);
+}
+
+/**
+ * @brief  This function returns the number of groups of 32 lanes up to and
+ *         including the highest group that holds a job of the queue.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @return  The number of groups to be scanned, or zero if the queue is empty.
+ */
+uint_fast16_t SchedulerPacked_GetGroups(const Scheduler_t* const sched)
+{
+    uint_fast16_t groups = SCHEDULER_PACKED_LANES / 32U;
+
+    while((groups > 0U) && (sched->queue.members[groups - 1U] == 0U))
+    {
+        --groups;
+    }
+
+    return groups;
+}
+
+/**
+ * @brief  This function counts down the lanes to the current time.
+ *
+ * The lanes up to the highest group that holds a job of the queue are counted
+ * down two at a time, regardless of whether their jobs are in the queue, and
+ * the bitmask of the due jobs is built. The lanes above it are left as they
+ * are: a job that is inserted there sets its lane from its deadline. The lanes
+ * of the far jobs are then recalculated from the deadlines of the jobs, which
+ * only costs time for the jobs that are further than the range of a lane, e.g.
+ * daily calendar jobs.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ */
+void SchedulerPacked_Advance(Scheduler_t* const sched,
+                             const uint32_t currentTime)
+{
+    const uint_fast16_t groups = SchedulerPacked_GetGroups(sched);
+    const uint32_t elapsed     = currentTime - sched->queue.time;
+    const uint32_t step =
+        PACKED_SPLAT((elapsed < PACKED_LANE_FAR) ? elapsed : PACKED_LANE_FAR);
+
+    for(uint_fast16_t word = 0U; word < (groups * 16U); ++word)
+    {
+        sched->queue.lanes[word] =
+            PACKED_SUB_SATURATE(sched->queue.lanes[word], step);
+    }
+
+    sched->queue.time = currentTime;
+
+    for(uint_fast16_t group = 0U; group < groups; ++group)
+    {
+        uint32_t far = sched->queue.far[group];
+
+        sched->queue.due[group] = SchedulerPacked_GetDueMask(sched, group) &
+                                  sched->queue.members[group];
+
+        for(uint_fast16_t i = group * 32U; far != 0U; ++i, far >>= 1U)
+        {
+            if((far & 1U) != 0U)
+            {
+                SchedulerPacked_SetLane(sched, (uint16_t)i);
+            }
+        }
+    }
+}
+
+/**
+ * @brief  This function returns the bitmask of the lanes that have reached
+ *         zero within a group of 32 lanes.
+ *
+ * Subtracting a lane from one with saturation yields one for a zero lane and
+ * zero otherwise, thus the bits of the mask are built without branches.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param group  The index of the group of lanes.
+ * @return  The bitmask of the zero lanes of the group.
+ */
+uint32_t SchedulerPacked_GetDueMask(const Scheduler_t* const sched,
+                                    const uint_fast16_t group)
+{
+    const uint32_t* const lanes = &sched->queue.lanes[group * 16U];
+    uint32_t mask               = 0U;
+
+    for(uint_fast16_t word = 0U; word < 16U; ++word)
+    {
+        const uint32_t zero =
+            PACKED_SUB_SATURATE(PACKED_SPLAT(1U), lanes[word]);
+        mask |= ((zero & 0x1U) | ((zero >> 15U) & 0x2U)) << (word * 2U);
+    }
+
+    return mask;
+}
+
+/**
+ * @brief  This function returns the remaining time of a lane.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the lane.
+ * @return  The remaining time in [s] of the lane.
+ */
+uint16_t SchedulerPacked_GetLane(const Scheduler_t* const sched,
+                                 const uint_fast16_t index)
+{
+    return (uint16_t)(sched->queue.lanes[index / PACKED_LANES_PER_WORD] >>
+                      ((index % PACKED_LANES_PER_WORD) * 16U));
+}
+
+/**
+ * @brief  This function subtracts the 16-bit lanes of two words, saturating
+ *         at zero. Portable equivalent of the UQSUB16 instruction.
+ *
+ * @param a  The minuend lanes.
+ * @param b  The subtrahend lanes.
+ * @return  The difference lanes.
+ */
+uint32_t SchedulerPacked_SubSaturate(const uint32_t a, const uint32_t b)
+{
+    const uint32_t low =
+        ((a & 0xFFFFU) > (b & 0xFFFFU)) ? ((a & 0xFFFFU) - (b & 0xFFFFU)) : 0U;
+    const uint32_t high =
+        ((a >> 16U) > (b >> 16U)) ? ((a >> 16U) - (b >> 16U)) : 0U;
+
+    return (high << 16U) | low;
+}
+
+/**
+ * @brief  This function selects the smaller of the 16-bit lanes of two words
+ *         with the USUB16 and SEL instruction pair, or with its portable
+ *         equivalent without the DSP extension.
+ *
+ * @param a  The first lanes.
+ * @param b  The second lanes.
+ * @return  The smaller lanes.
+ */
+uint32_t SchedulerPacked_Min(const uint32_t a, const uint32_t b)
+{
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    uint32_t minimum;
+
+    /* USUB16 sets the GE flags of the lanes where a is not smaller than b, then
+     * SEL picks these lanes from b. The GE flags are not visible to the
+     * compiler, thus both instructions are kept in a single block. */
+    __ASM volatile("usub16 %0, %1, %2\n\t"
+                   "sel %0, %2, %1"
+                   : "=&r"(minimum)
+                   : "r"(a), "r"(b)
+                   : "cc");
+
+    return minimum;
+#else
+    const uint32_t low =
+        ((a & 0xFFFFU) < (b & 0xFFFFU)) ? (a & 0xFFFFU) : (b & 0xFFFFU);
+    const uint32_t high = ((a >> 16U) < (b >> 16U)) ? (a >> 16U) : (b >> 16U);
+
+    return (high << 16U) | low;
+#endif
+}
+
+#endif /* SCHEDULER_QUEUE_PACKED */
@@ -0,0 +1,79 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_task.c
+ * @brief   This file contains the binding of the jobs of the scheduler directly
+ *          to RTOS tasks.
+ *
+ * A task job has no callback: when it becomes due, the task given upon adding
+ * the job receives a direct task notification from the RTC alarm interrupt
+ * handler. Thus no trampoline callback and no context switch to the dispatcher
+ * task is needed for jobs that only unblock a task.
+ *
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler_task.h"
+#include "scheduler_mux.h"
+
+/**
+ * @brief  Add a new job to the scheduler that notifies an RTOS task.
+ *
+ * Each pending execution of the job gives a task notification to the task,
+ * which can be taken by the task with the ulTaskNotifyTake() function.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        including the callbacks of the jobs.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param period  The period in [s] which the job needs to be executed, up to
+ *                ::SCHEDULER_MAX_PERIOD.
+ * @param task    The handle of the task that is notified upon job execution.
+ * @return  The handle of the job if the job has been successfully added;
+ *          otherwise ::SCHEDULER_INVALID_HANDLE.
+ */
+JobHandle_t SchedulerAddTaskJob(Scheduler_t* const sched,
+                                const uint32_t period,
+                                const TaskHandle_t task)
+{
+    assert_param(task != NULL);
+
+    return SchedulerAddJob(sched, period, NULL, task);
+}
+
+/**
+ * @brief  Notify the tasks of the task jobs of the attached scheduler instances
+ *         that are ready for execution.
+ *
+ * The function does not request a context switch; the caller needs to yield
+ * once at the end of the interrupt handler if a higher priority task has been
+ * woken, regardless of the number of notified tasks.
+ *
+ * @note  This function must be called from the RTC alarm interrupt handler,
+ *        after processing the scheduler instances.
+ *
+ * @param higherPriorityTaskWoken  Pointer to the flag that is set to pdTRUE if
+ *                                 a notified task has a higher priority than
+ *                                 the interrupted task.
+ */
+void SchedulerTaskNotifyFromISR(BaseType_t* const higherPriorityTaskWoken)
+{
+    void* context = NULL;
+    uint8_t count = 0U;
+
+    while(SchedulerMuxTakeNotification(&context, &count) != 0U)
+    {
+        while(count != 0U)
+        {
+            vTaskNotifyGiveFromISR((TaskHandle_t)context,
+                                   higherPriorityTaskWoken);
+            --count;
+        }
+    }
+}
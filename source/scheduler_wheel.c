@@ -0,0 +1,460 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    scheduler_wheel.c
+ * @brief   This file contains the hierarchical timing wheel queue backend of
+ *          the scheduler.
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler_queue.h"
+
+#if(SCHEDULER_QUEUE == SCHEDULER_QUEUE_WHEEL)
+
+/* Private defines -----------------------------------------------------------*/
+/** Slot identifier of a job that has expired */
+#define WHEEL_SLOT_EXPIRED 0xFEU
+/** Slot identifier of a job whose deadline is beyond the range of the wheel */
+#define WHEEL_SLOT_OVERFLOW 0xFDU
+
+/** Create a slot identifier from a level and a slot index */
+#define WHEEL_SLOT_ID(level, slot) ((uint8_t)(((level) << 6U) | (slot)))
+
+/* Private variables ---------------------------------------------------------*/
+/** The resolution in [s] of the slots on each level of the wheel */
+static const uint32_t wheelResolution[SCHEDULER_WHEEL_LEVELS] = {
+    1U, 60U, 3600U, 86400U};
+
+/** The number of slots on each level of the wheel */
+static const uint8_t wheelSize[SCHEDULER_WHEEL_LEVELS] = {60U, 60U, 24U, 32U};
+
+/* Private function prototypes -----------------------------------------------*/
+uint_fast8_t SchedulerWheel_FindFirstSlot(const uint64_t occupied,
+                                          const uint_fast8_t start);
+uint16_t* SchedulerWheel_GetList(Scheduler_t* const sched,
+                                 const uint8_t slotId);
+void SchedulerWheel_Link(Scheduler_t* const sched,
+                         const uint16_t index,
+                         const uint8_t slotId);
+void SchedulerWheel_LinkExpired(Scheduler_t* const sched, const uint16_t index);
+void SchedulerWheel_Advance(Scheduler_t* const sched,
+                            const uint32_t currentTime);
+void SchedulerWheel_Cascade(Scheduler_t* const sched, uint16_t* const list);
+
+/**
+ * @brief  Initialize the queue by removing all jobs from the wheel.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch) the wheel starts from.
+ */
+void SchedulerQueueInit(Scheduler_t* const sched, const uint32_t currentTime)
+{
+    sched->queue.time     = currentTime;
+    sched->queue.expired  = SCHEDULER_NO_JOB;
+    sched->queue.overflow = SCHEDULER_NO_JOB;
+
+    for(uint_fast8_t level = 0U; level < SCHEDULER_WHEEL_LEVELS; ++level)
+    {
+        sched->queue.occupied[level] = 0U;
+        for(uint_fast8_t slot = 0U; slot < SCHEDULER_WHEEL_SLOTS; ++slot)
+        {
+            sched->queue.slots[level][slot] = SCHEDULER_NO_JOB;
+        }
+    }
+}
+
+/**
+ * @brief  Insert a job into the wheel according to its deadline in O(1).
+ *
+ * The job is placed on the lowest level whose slots can hold its deadline
+ * without wrapping around. Deadlines that are beyond the range of the highest
+ * level are placed into an overflow list that is re-inserted each time the
+ * highest level advances.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void SchedulerQueueInsert(Scheduler_t* const sched, const uint16_t index)
+{
+    const uint32_t deadline = sched->jobs[index].deadline;
+
+    if(deadline <= sched->queue.time)
+    {
+        SchedulerWheel_LinkExpired(sched, index);
+    }
+    else
+    {
+        /* Deadline is out of range unless a level is found below */
+        uint8_t slotId = WHEEL_SLOT_OVERFLOW;
+
+        for(uint_fast8_t level = 0U; level < SCHEDULER_WHEEL_LEVELS; ++level)
+        {
+            const uint32_t tick = deadline / wheelResolution[level];
+            if((tick - (sched->queue.time / wheelResolution[level])) <
+               wheelSize[level])
+            {
+                slotId = WHEEL_SLOT_ID(level, tick % wheelSize[level]);
+                break;
+            }
+        }
+
+        SchedulerWheel_Link(sched, index, slotId);
+    }
+}
+
+/**
+ * @brief  Remove a job from the wheel in O(1).
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void SchedulerQueueRemove(Scheduler_t* const sched, const uint16_t index)
+{
+    SchedulerQueueLink_t* const link = &sched->jobs[index].link;
+
+    uint16_t* const head = SchedulerWheel_GetList(sched, link->slot);
+    if(link->prev != SCHEDULER_NO_JOB)
+    {
+        sched->jobs[link->prev].link.next = link->next;
+    }
+    else
+    {
+        *head = link->next;
+    }
+
+    if(link->next != SCHEDULER_NO_JOB)
+    {
+        sched->jobs[link->next].link.prev = link->prev;
+    }
+
+    if((link->slot < WHEEL_SLOT_OVERFLOW) && (*head == SCHEDULER_NO_JOB))
+    {
+        sched->queue.occupied[link->slot >> 6U] &=
+            ~((uint64_t)1U << (link->slot & 0x3FU));
+    }
+}
+
+/**
+ * @brief  Get the job with the earliest deadline of the wheel.
+ *
+ * The first non-empty slot of each level is searched with the help of the
+ * occupancy bitmasks, thus the cost is bounded by the number of levels and the
+ * number of jobs in these slots and in the overflow list.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  Pointer where the index of the job with the earliest deadline
+ *               is written.
+ * @return  A non-zero value if the wheel is not empty; otherwise zero.
+ */
+uint8_t SchedulerQueuePeek(Scheduler_t* const sched, uint16_t* const index)
+{
+    uint8_t result = 0U;
+
+    if(sched->queue.expired != SCHEDULER_NO_JOB)
+    {
+        *index = sched->queue.expired;
+        result = 1U;
+    }
+    else
+    {
+        for(uint_fast8_t level = 0U; level <= SCHEDULER_WHEEL_LEVELS; ++level)
+        {
+            uint16_t job = SCHEDULER_NO_JOB;
+
+            if(level == SCHEDULER_WHEEL_LEVELS)
+            {
+                job = sched->queue.overflow;
+            }
+            else if(sched->queue.occupied[level] != 0U)
+            {
+                const uint_fast8_t start =
+                    ((sched->queue.time / wheelResolution[level]) + 1U) %
+                    wheelSize[level];
+                const uint_fast8_t slot = SchedulerWheel_FindFirstSlot(
+                    sched->queue.occupied[level], start);
+                job = sched->queue.slots[level][slot];
+            }
+
+            while(job != SCHEDULER_NO_JOB)
+            {
+                if((result == 0U) ||
+                   (sched->jobs[job].deadline < sched->jobs[*index].deadline))
+                {
+                    *index = job;
+                    result = 1U;
+                }
+                job = sched->jobs[job].link.next;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Remove the job with the earliest deadline from the wheel if it is
+ *         due.
+ *
+ * The wheel is advanced lazily to the current time upon the first call after a
+ * wakeup: only the slots whose time has been reached are cascaded.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ * @param index        Pointer where the index of the due job is written.
+ * @return  A non-zero value if a due job has been removed; otherwise zero.
+ */
+uint8_t SchedulerQueuePopDue(Scheduler_t* const sched,
+                             const uint32_t currentTime,
+                             uint16_t* const index)
+{
+    uint8_t result = 0U;
+
+    if(currentTime > sched->queue.time)
+    {
+        SchedulerWheel_Advance(sched, currentTime);
+    }
+
+    if((sched->queue.expired != SCHEDULER_NO_JOB) &&
+       (sched->jobs[sched->queue.expired].deadline <= currentTime))
+    {
+        *index = sched->queue.expired;
+        SchedulerQueueRemove(sched, *index);
+        result = 1U;
+    }
+    else
+    {
+        result = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  This function finds the first non-empty slot of a level, starting
+ *         from a given slot and wrapping around at the end of the level.
+ *
+ * @param occupied  Bitmask of the non-empty slots of the level.
+ * @param start     The slot index where the search starts.
+ * @return  The index of the first non-empty slot.
+ */
+uint_fast8_t SchedulerWheel_FindFirstSlot(const uint64_t occupied,
+                                          const uint_fast8_t start)
+{
+    uint64_t mask      = occupied >> start;
+    uint_fast8_t first = start;
+
+    if(mask == 0U)
+    {
+        mask  = occupied;
+        first = 0U;
+    }
+
+    /* Count trailing zeros */
+    if((uint32_t)mask != 0U)
+    {
+        first += __CLZ(__RBIT((uint32_t)mask));
+    }
+    else
+    {
+        first += 32U + __CLZ(__RBIT((uint32_t)(mask >> 32U)));
+    }
+
+    return first;
+}
+
+/**
+ * @brief  This function returns the head of the list of jobs identified by a
+ *         slot identifier.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param slotId  The slot identifier.
+ * @return  Pointer to the index of the first job of the list.
+ */
+uint16_t* SchedulerWheel_GetList(Scheduler_t* const sched,
+                                 const uint8_t slotId)
+{
+    uint16_t* head = NULL;
+
+    if(slotId == WHEEL_SLOT_EXPIRED)
+    {
+        head = &sched->queue.expired;
+    }
+    else if(slotId == WHEEL_SLOT_OVERFLOW)
+    {
+        head = &sched->queue.overflow;
+    }
+    else
+    {
+        head = &sched->queue.slots[slotId >> 6U][slotId & 0x3FU];
+    }
+
+    return head;
+}
+
+/**
+ * @brief  This function links a job into a slot of the wheel or into the
+ *         overflow list.
+ *
+ * @param sched   Pointer to the scheduler.
+ * @param index   The index of the job.
+ * @param slotId  The slot identifier.
+ */
+void SchedulerWheel_Link(Scheduler_t* const sched,
+                         const uint16_t index,
+                         const uint8_t slotId)
+{
+    SchedulerQueueLink_t* const link = &sched->jobs[index].link;
+    uint16_t* const head             = SchedulerWheel_GetList(sched, slotId);
+
+    link->next = *head;
+    link->prev = SCHEDULER_NO_JOB;
+    link->slot = slotId;
+
+    if(*head != SCHEDULER_NO_JOB)
+    {
+        sched->jobs[*head].link.prev = index;
+    }
+
+    *head = index;
+
+    if(slotId < WHEEL_SLOT_OVERFLOW)
+    {
+        sched->queue.occupied[slotId >> 6U] |=
+            ((uint64_t)1U << (slotId & 0x3FU));
+    }
+}
+
+/**
+ * @brief  This function links a job into the list of expired jobs, keeping the
+ *         list ordered by deadline.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param index  The index of the job.
+ */
+void SchedulerWheel_LinkExpired(Scheduler_t* const sched, const uint16_t index)
+{
+    SchedulerQueueLink_t* const link = &sched->jobs[index].link;
+    const uint32_t deadline          = sched->jobs[index].deadline;
+    uint16_t prev                    = SCHEDULER_NO_JOB;
+    uint16_t next                    = sched->queue.expired;
+
+    while((next != SCHEDULER_NO_JOB) &&
+          (sched->jobs[next].deadline <= deadline))
+    {
+        prev = next;
+        next = sched->jobs[next].link.next;
+    }
+
+    link->next = next;
+    link->prev = prev;
+    link->slot = WHEEL_SLOT_EXPIRED;
+
+    if(prev != SCHEDULER_NO_JOB)
+    {
+        sched->jobs[prev].link.next = index;
+    }
+    else
+    {
+        sched->queue.expired = index;
+    }
+
+    if(next != SCHEDULER_NO_JOB)
+    {
+        sched->jobs[next].link.prev = index;
+    }
+}
+
+/**
+ * @brief  This function advances the wheel to the current time.
+ *
+ * On each level, the slots whose time has been reached since the last advance
+ * are cascaded: their jobs are re-inserted relative to the current time, thus
+ * they either expire or move to a lower level. When the elapsed time exceeds
+ * the range of a level, all non-empty slots of that level are cascaded. The
+ * overflow list is re-inserted whenever the highest level advances.
+ *
+ * @param sched        Pointer to the scheduler.
+ * @param currentTime  The current time (Unix epoch).
+ */
+void SchedulerWheel_Advance(Scheduler_t* const sched,
+                            const uint32_t currentTime)
+{
+    const uint32_t previousTime = sched->queue.time;
+    sched->queue.time           = currentTime;
+
+    for(uint_fast8_t level = 0U; level < SCHEDULER_WHEEL_LEVELS; ++level)
+    {
+        const uint32_t firstTick = (previousTime / wheelResolution[level]) + 1U;
+        const uint32_t lastTick  = currentTime / wheelResolution[level];
+
+        if(lastTick < firstTick)
+        {
+            /* No slot boundary has been crossed on this level */
+        }
+        else if((lastTick - firstTick) >= (wheelSize[level] - 1U))
+        {
+            /* Every slot has been reached: cascade all non-empty slots */
+            uint64_t occupied = sched->queue.occupied[level];
+            while(occupied != 0U)
+            {
+                const uint_fast8_t slot =
+                    SchedulerWheel_FindFirstSlot(occupied, 0U);
+                occupied &= ~((uint64_t)1U << slot);
+                SchedulerWheel_Cascade(sched, &sched->queue.slots[level][slot]);
+                sched->queue.occupied[level] &= ~((uint64_t)1U << slot);
+            }
+        }
+        else
+        {
+            for(uint32_t tick = firstTick; tick <= lastTick; ++tick)
+            {
+                const uint_fast8_t slot = tick % wheelSize[level];
+                if((sched->queue.occupied[level] & ((uint64_t)1U << slot)) !=
+                   0U)
+                {
+                    SchedulerWheel_Cascade(sched,
+                                           &sched->queue.slots[level][slot]);
+                    sched->queue.occupied[level] &= ~((uint64_t)1U << slot);
+                }
+            }
+        }
+    }
+
+    if((currentTime / wheelResolution[SCHEDULER_WHEEL_LEVELS - 1U]) !=
+       (previousTime / wheelResolution[SCHEDULER_WHEEL_LEVELS - 1U]))
+    {
+        SchedulerWheel_Cascade(sched, &sched->queue.overflow);
+    }
+}
+
+/**
+ * @brief  This function empties a list of jobs and re-inserts its jobs
+ *         relative to the current time of the wheel.
+ *
+ * @note  The caller is responsible for updating the occupancy bitmask of the
+ *        emptied slot.
+ *
+ * @param sched  Pointer to the scheduler.
+ * @param list   Pointer to the head of the list.
+ */
+void SchedulerWheel_Cascade(Scheduler_t* const sched, uint16_t* const list)
+{
+    uint16_t index = *list;
+
+    *list = SCHEDULER_NO_JOB;
+
+    while(index != SCHEDULER_NO_JOB)
+    {
+        const uint16_t next = sched->jobs[index].link.next;
+        SchedulerQueueInsert(sched, index);
+        index = next;
+    }
+}
+
+#endif /* SCHEDULER_QUEUE_WHEEL */
@@ -12,13 +12,27 @@
  */
 
 /* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
 #include "core_stop.h"
 #include "error_handler.h"
-#include "scheduler.h"
+#include "rtc.h"
+#include "scheduler_mux.h"
+#include "scheduler_task.h"
+#include "task.h"
 
 /* External variables --------------------------------------------------------*/
 extern RTC_HandleTypeDef hrtc;
 extern TIM_HandleTypeDef htim17;
+extern TaskHandle_t taskHandleSchedulerDispatcher;
+
+#ifdef RTC_ALARM_IRQ_PROFILING
+/* Private variables ---------------------------------------------------------*/
+/** The worst-case execution time of the RTC alarm interrupt handler in CPU
+ * cycles, measured by the DWT cycle counter. The cycles are counted at the
+ * clock frequency that is in effect, i.e. at the MSI clock after a wakeup from
+ * STOP2 mode. */
+volatile uint32_t rtcAlarmIrqMaxCycles = 0U;
+#endif
 
 /******************************************************************************/
 /*           Cortex-M4 Processor Interruption and Exception Handlers          */
@@ -88,17 +102,66 @@ void TIM1_TRG_COM_TIM17_IRQHandler(void)
 
 /**
  * @brief  This function handles the RTC alarm interrupts.
+ *
+ * The handler is kept short, since it blocks the interrupts of lower or equal
+ * priority: it only processes the scheduler instances, which queue the due jobs
+ * and configure the next RTC alarm. Restoring the clocks after a wakeup from
+ * STOP2 mode and executing the callbacks of the jobs are deferred to the
+ * dispatcher task.
  */
 void RTC_Alarm_IRQHandler(void)
 {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+#ifdef RTC_ALARM_IRQ_PROFILING
+    if((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0U;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    const uint32_t startCycles = DWT->CYCCNT;
+#endif
+
     HAL_RTC_AlarmIRQHandler(&hrtc);
 
-    /* Resume operation from STOP2 mode */
-    ResumeFromStop2Mode();
+    /* Synchronize the calendar registers after a wakeup from STOP2 mode. The
+     * clock configuration is restored by the dispatcher task. */
+    if(IsCoreStopped() != 0U)
+    {
+        RtcWaitForClockSynchronization();
+    }
+
+    /* Process the scheduler instances, then notify the tasks of the task jobs
+     * directly */
+    const uint8_t hasPendingJobs = SchedulerMuxProcess();
+    SchedulerTaskNotifyFromISR(&xHigherPriorityTaskWoken);
+
+    /* The RTC alarm could not be configured, thus the scheduler would not wake
+     * up again */
+    if(SchedulerMuxGetAlarmErrors() != 0U)
+    {
+        ErrorHandler();
+    }
+
+    /* Notify the dispatcher task if jobs are ready for execution, or if the
+     * clock configuration needs to be restored. The dispatcher task has a
+     * higher priority than the application tasks, thus it resumes from STOP2
+     * mode before the notified tasks run. */
+    if((hasPendingJobs != 0U) || (IsCoreStopped() != 0U))
+    {
+        vTaskNotifyGiveFromISR(taskHandleSchedulerDispatcher,
+                               &xHigherPriorityTaskWoken);
+    }
 
-    /* Process the scheduler */
-    SchedulerProcess();
+#ifdef RTC_ALARM_IRQ_PROFILING
+    const uint32_t cycles = DWT->CYCCNT - startCycles;
+    if(cycles > rtcAlarmIrqMaxCycles)
+    {
+        rtcAlarmIrqMaxCycles = cycles;
+    }
+#endif
 
-    /* Execute the pending jobs */
-    SchedulerExecutePendingJobs();
+    /* Request a single context switch for all the notified tasks */
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
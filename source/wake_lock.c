@@ -0,0 +1,150 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    wake_lock.c
+ * @brief   This file contains the implementation of the wake locks that inhibit
+ *          the STOP2 mode.
+ *
+ * A job that starts a DMA or peripheral transfer and waits for its completion
+ * interrupt acquires a wake lock, and the interrupt handler releases it. While
+ * any lock is held, the idle hook only enters the sleep mode, in which the
+ * clocks and the peripherals keep running. The locks are reference counted and
+ * updated with the interrupts masked for a few instructions, thus they can be
+ * acquired and released from tasks and interrupt handlers.
+ *
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "wake_lock.h"
+
+/* Private variables ---------------------------------------------------------*/
+/** The number of wake locks that are held */
+static volatile uint32_t heldLocks = 0U;
+
+/**
+ * @brief  Initialize a wake lock in the released state.
+ *
+ * @param lock  Pointer to the wake lock.
+ */
+void WakeLockInit(WakeLock_t* const lock)
+{
+    assert_param(lock != NULL);
+
+    lock->count               = 0U;
+    lock->holdStart           = 0U;
+    lock->stats.holds         = 0U;
+    lock->stats.totalHoldTime = 0U;
+    lock->stats.maxHoldTime   = 0U;
+}
+
+/**
+ * @brief  Acquire a wake lock.
+ *
+ * The STOP2 mode is inhibited until each acquisition of the lock has been
+ * released.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers.
+ *
+ * @param lock  Pointer to the wake lock.
+ */
+void WakeLockAcquire(WakeLock_t* const lock)
+{
+    /* The reference count, the hold start and the number of held locks are
+     * updated together, thus an interrupt never sees them inconsistent */
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if(lock->count == 0U)
+    {
+        /* The lock is taken: start the hold time */
+        lock->holdStart = HAL_GetTick();
+        ++heldLocks;
+    }
+    else
+    {
+        /* The lock is already held */
+    }
+    ++lock->count;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  Release an acquisition of a wake lock.
+ *
+ * @note  This function can be called from tasks and from interrupt handlers,
+ *        e.g. from the completion interrupt of a transfer.
+ *
+ * @param lock  Pointer to the wake lock.
+ */
+void WakeLockRelease(WakeLock_t* const lock)
+{
+    assert_param(lock->count != 0U);
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    --lock->count;
+    if(lock->count == 0U)
+    {
+        /* The lock is released: record the hold time */
+        const uint32_t holdTime = HAL_GetTick() - lock->holdStart;
+
+        ++lock->stats.holds;
+        lock->stats.totalHoldTime += holdTime;
+        if(holdTime > lock->stats.maxHoldTime)
+        {
+            lock->stats.maxHoldTime = holdTime;
+        }
+        --heldLocks;
+    }
+    else
+    {
+        /* The lock is still held by other acquisitions */
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  Check whether any wake lock is held.
+ *
+ * The function is used by the idle hook to decide whether the STOP2 mode may be
+ * entered.
+ *
+ * @return  A non-zero value if at least one wake lock is held; otherwise zero.
+ */
+uint8_t WakeLockIsAnyHeld(void)
+{
+    return (heldLocks != 0U) ? 1U : 0U;
+}
+
+/**
+ * @brief  Get the hold-time statistics of a wake lock.
+ *
+ * The hold time is measured by the HAL tick, thus it has a resolution of one
+ * millisecond. The current hold of a held lock is not included.
+ *
+ * @param lock   Pointer to the wake lock.
+ * @param stats  Pointer where the statistics are written.
+ */
+void WakeLockGetStats(const WakeLock_t* const lock,
+                      WakeLockStats_t* const stats)
+{
+    assert_param(stats != NULL);
+
+    /* The statistics are copied at once, thus a release in the meantime does
+     * not tear them */
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    *stats = lock->stats;
+
+    __set_PRIMASK(primask);
+}
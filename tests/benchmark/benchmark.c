@@ -0,0 +1,443 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    benchmark.c
+ * @brief   This file contains the host benchmark of the scheduler. The cost
+ *          per wakeup, per insertion and per cancellation of the queue
+ *          backend selected by SCHEDULER_QUEUE is compared against the linear
+ *          scan of the original scheduler.
+ *
+ * Both schedulers run the same job set for the same number of wakeups. The
+ * number of executions is compared at the end, thus the benchmark also fails
+ * if the schedulers disagree. The results are reported in nanoseconds of the
+ * host, which only allows comparing the algorithms relative to each other.
+ *
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rtc.h"
+#include "scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Private defines -----------------------------------------------------------*/
+/** The largest number of jobs of the benchmark */
+#define BENCHMARK_MAX_JOBS 1000U
+
+/** The largest capacity of the scheduler, which is limited by the lanes of the
+ * packed queue backend */
+#if(SCHEDULER_QUEUE == SCHEDULER_QUEUE_PACKED)
+#define BENCHMARK_CAPACITY SCHEDULER_PACKED_LANES
+#else
+#define BENCHMARK_CAPACITY (BENCHMARK_MAX_JOBS + 1U)
+#endif
+
+/** The number of wakeups measured per job count */
+#define BENCHMARK_WAKEUPS 20000U
+
+/** The number of insertions and cancellations measured per job count */
+#define BENCHMARK_UPDATES 2000U
+
+/** The number of repetitions, the fastest of which is reported */
+#define BENCHMARK_REPETITIONS 3U
+
+/** The time (Unix epoch) when the schedulers are started */
+#define BENCHMARK_START_TIME 1000000U
+
+/* Private typedefs ----------------------------------------------------------*/
+/** Structure of a job of the linear scan, as in the original scheduler */
+typedef struct
+{
+    uint32_t period;
+    uint32_t remainingTime;
+    uint8_t isPending;
+    Callback_t callback;
+} LinearJob_t;
+
+/* Private variables ---------------------------------------------------------*/
+static Scheduler_t sched;
+static SCHEDULER_STORAGE_DEFINE(storage, BENCHMARK_MAX_JOBS + 1U);
+
+static LinearJob_t linearJobs[BENCHMARK_MAX_JOBS + 1U];
+static uint32_t linearJobCount = 0U;
+
+static uint32_t periods[BENCHMARK_MAX_JOBS];
+static uint32_t executions = 0U;
+
+/* Private function prototypes -----------------------------------------------*/
+int Benchmark_Run(const uint32_t count);
+void Benchmark_GeneratePeriods(const uint32_t count);
+void Benchmark_Callback(void* context);
+uint64_t Benchmark_GetTime(void);
+uint64_t Benchmark_RunScheduler(const uint32_t count, uint32_t* const endTime);
+uint64_t Benchmark_RunLinear(const uint32_t count, const uint32_t endTime);
+void Benchmark_UpdateScheduler(const uint32_t count,
+                               const uint32_t currentTime,
+                               uint64_t* const insertTime,
+                               uint64_t* const cancelTime);
+void Benchmark_UpdateLinear(const uint32_t count,
+                            uint64_t* const insertTime,
+                            uint64_t* const cancelTime);
+uint32_t Linear_Process(const uint32_t elapsedTime);
+void Linear_ExecutePendingJobs(void);
+
+/* The RTC and the HAL tick are not used by the measured code paths */
+void RtcTriggerAlarmInterrupt(void)
+{
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return 0U;
+}
+
+/**
+ * @brief  Run the benchmarks for 8, 10, 32, 100, 256 and 1000 jobs. The job
+ *         sets that do not fit into the lanes of the packed queue backend are
+ *         skipped.
+ *
+ * @return  Zero if the schedulers agree on the number of executions;
+ *          otherwise one.
+ */
+int main(void)
+{
+    static const uint32_t counts[] = {8U, 10U, 32U, 100U, 256U, 1000U};
+    int result                     = 0;
+
+    printf("Queue backend: %u, %u wakeups and %u insertions and "
+           "cancellations per job count\n",
+           (unsigned)SCHEDULER_QUEUE,
+           (unsigned)BENCHMARK_WAKEUPS,
+           (unsigned)BENCHMARK_UPDATES);
+    printf("%6s %14s %14s %14s %14s %14s %14s\n", "Jobs", "Wakeup [ns]",
+           "Linear [ns]", "Insert [ns]", "Linear [ns]", "Cancel [ns]",
+           "Linear [ns]");
+
+    for(size_t i = 0U; i < (sizeof(counts) / sizeof(counts[0])); ++i)
+    {
+        /* One slot is left free for the insertions */
+        if((counts[i] + 1U) > BENCHMARK_CAPACITY)
+        {
+            printf("%6u %14s\n", (unsigned)counts[i], "skipped");
+        }
+        else if(Benchmark_Run(counts[i]) != 0)
+        {
+            result = 1;
+        }
+        else
+        {
+            /* The schedulers agree */
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Run the benchmark for a number of jobs and print its results.
+ *
+ * @param count  The number of jobs.
+ * @return  Zero if the schedulers agree on the number of executions;
+ *          otherwise one.
+ */
+int Benchmark_Run(const uint32_t count)
+{
+    int result             = 0;
+    uint64_t queueTime     = UINT64_MAX;
+    uint64_t linearTime    = UINT64_MAX;
+    uint32_t queueExecuted = 0U;
+    uint32_t endTime       = 0U;
+    uint64_t queueInsert   = 0U;
+    uint64_t queueCancel   = 0U;
+    uint64_t linearInsert  = 0U;
+    uint64_t linearCancel  = 0U;
+
+    Benchmark_GeneratePeriods(count);
+
+    for(uint32_t r = 0U; r < BENCHMARK_REPETITIONS; ++r)
+    {
+        const uint64_t time = Benchmark_RunScheduler(count, &endTime);
+        queueTime           = (time < queueTime) ? time : queueTime;
+    }
+    queueExecuted = executions;
+    Benchmark_UpdateScheduler(count, endTime, &queueInsert, &queueCancel);
+
+    for(uint32_t r = 0U; r < BENCHMARK_REPETITIONS; ++r)
+    {
+        const uint64_t time = Benchmark_RunLinear(count, endTime);
+        linearTime          = (time < linearTime) ? time : linearTime;
+    }
+    Benchmark_UpdateLinear(count, &linearInsert, &linearCancel);
+
+    printf("%6u %14.1f %14.1f %14.1f %14.1f %14.1f %14.1f\n",
+           (unsigned)count,
+           (double)queueTime / BENCHMARK_WAKEUPS,
+           (double)linearTime / BENCHMARK_WAKEUPS,
+           (double)queueInsert / BENCHMARK_UPDATES,
+           (double)linearInsert / BENCHMARK_UPDATES,
+           (double)queueCancel / BENCHMARK_UPDATES,
+           (double)linearCancel / BENCHMARK_UPDATES);
+
+    if(queueExecuted != executions)
+    {
+        printf("Mismatch: %u executions with the queue, %u with the "
+               "linear scan\n",
+               (unsigned)queueExecuted,
+               (unsigned)executions);
+        result = 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Generate the periods of the jobs between 10 s and one hour with a
+ *         fixed pseudo-random sequence.
+ *
+ * @param count  The number of jobs.
+ */
+void Benchmark_GeneratePeriods(const uint32_t count)
+{
+    uint32_t seed = 12345U;
+
+    for(uint32_t i = 0U; i < count; ++i)
+    {
+        seed       = (seed * 1103515245U) + 12345U;
+        periods[i] = 10U + ((seed >> 8U) % 3591U);
+    }
+}
+
+/**
+ * @brief  Count the executions of the jobs.
+ *
+ * @param context  Unused.
+ */
+void Benchmark_Callback(void* context)
+{
+    (void)context;
+    ++executions;
+}
+
+/**
+ * @brief  Get the monotonic time of the host.
+ *
+ * @return  The time in [ns].
+ */
+uint64_t Benchmark_GetTime(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief  Run the scheduler for the benchmarked number of wakeups.
+ *
+ * Each wakeup processes the scheduler at the deadline that it has reported
+ * and executes the pending jobs, as upon an RTC alarm.
+ *
+ * @param count    The number of jobs.
+ * @param endTime  Pointer where the time of the last wakeup is written.
+ * @return  The time spent in the wakeups in [ns].
+ */
+uint64_t Benchmark_RunScheduler(const uint32_t count, uint32_t* const endTime)
+{
+    uint32_t nextDeadline = 0U;
+
+    /* One slot is left free for the insertions */
+    SchedulerInit(
+        &sched, storage.jobs, storage.jobData, storage.bitmaps, count + 1U);
+    for(uint32_t i = 0U; i < count; ++i)
+    {
+        (void)SchedulerAddJob(&sched, periods[i], Benchmark_Callback, NULL);
+    }
+    SchedulerStart(&sched);
+    (void)SchedulerProcess(&sched, BENCHMARK_START_TIME, &nextDeadline);
+    executions = 0U;
+
+    const uint64_t startTime = Benchmark_GetTime();
+    for(uint32_t w = 0U; w < BENCHMARK_WAKEUPS; ++w)
+    {
+        *endTime = nextDeadline;
+        (void)SchedulerProcess(&sched, nextDeadline, &nextDeadline);
+        SchedulerExecutePendingJobs(&sched);
+    }
+
+    return Benchmark_GetTime() - startTime;
+}
+
+/**
+ * @brief  Run the linear scan until a given time.
+ *
+ * @param count    The number of jobs.
+ * @param endTime  The time (Unix epoch) of the last wakeup.
+ * @return  The time spent in the wakeups in [ns].
+ */
+uint64_t Benchmark_RunLinear(const uint32_t count, const uint32_t endTime)
+{
+    uint32_t currentTime = BENCHMARK_START_TIME;
+
+    linearJobCount = count;
+    for(uint32_t i = 0U; i < count; ++i)
+    {
+        linearJobs[i].period        = periods[i];
+        linearJobs[i].remainingTime = periods[i];
+        linearJobs[i].isPending     = 0U;
+        linearJobs[i].callback      = Benchmark_Callback;
+    }
+    uint32_t nextTime = currentTime + Linear_Process(0U);
+    executions        = 0U;
+
+    const uint64_t startTime = Benchmark_GetTime();
+    while(nextTime <= endTime)
+    {
+        const uint32_t elapsedTime = nextTime - currentTime;
+        currentTime                = nextTime;
+        nextTime = currentTime + Linear_Process(elapsedTime);
+        Linear_ExecutePendingJobs();
+    }
+
+    return Benchmark_GetTime() - startTime;
+}
+
+/**
+ * @brief  Insert and cancel a job while the scheduler is running.
+ *
+ * Each insertion and cancellation is applied by processing the scheduler, as
+ * upon the RTC alarm interrupt that the request sets pending. The scheduler
+ * must have been run by ::Benchmark_RunScheduler() before.
+ *
+ * @param count        The number of jobs.
+ * @param currentTime  The time (Unix epoch) of the last wakeup.
+ * @param insertTime   Pointer where the time spent in the insertions is
+ *                     written in [ns].
+ * @param cancelTime   Pointer where the time spent in the cancellations is
+ *                     written in [ns].
+ */
+void Benchmark_UpdateScheduler(const uint32_t count,
+                               const uint32_t currentTime,
+                               uint64_t* const insertTime,
+                               uint64_t* const cancelTime)
+{
+    uint32_t nextDeadline = 0U;
+
+    *insertTime = 0U;
+    *cancelTime = 0U;
+
+    for(uint32_t u = 0U; u < BENCHMARK_UPDATES; ++u)
+    {
+        const uint64_t startTime = Benchmark_GetTime();
+        const JobHandle_t handle = SchedulerAddJob(
+            &sched, periods[u % count], Benchmark_Callback, NULL);
+        (void)SchedulerProcess(&sched, currentTime, &nextDeadline);
+        const uint64_t insertedTime = Benchmark_GetTime();
+        (void)SchedulerCancelJob(&sched, handle);
+        (void)SchedulerProcess(&sched, currentTime, &nextDeadline);
+        const uint64_t cancelledTime = Benchmark_GetTime();
+
+        *insertTime += insertedTime - startTime;
+        *cancelTime += cancelledTime - insertedTime;
+    }
+}
+
+/**
+ * @brief  Insert and cancel a job of the linear scan.
+ *
+ * The original scheduler could only add jobs while it was stopped and could
+ * not cancel them. The cheapest equivalents are measured: a job is appended or
+ * removed from the end of the array, then the job with the lowest remaining
+ * time is searched again to configure the RTC alarm. The linear scan must have
+ * been run by ::Benchmark_RunLinear() before.
+ *
+ * @param count       The number of jobs.
+ * @param insertTime  Pointer where the time spent in the insertions is written
+ *                    in [ns].
+ * @param cancelTime  Pointer where the time spent in the cancellations is
+ *                    written in [ns].
+ */
+void Benchmark_UpdateLinear(const uint32_t count,
+                            uint64_t* const insertTime,
+                            uint64_t* const cancelTime)
+{
+    *insertTime = 0U;
+    *cancelTime = 0U;
+
+    for(uint32_t u = 0U; u < BENCHMARK_UPDATES; ++u)
+    {
+        const uint64_t startTime = Benchmark_GetTime();
+        linearJobs[count].period        = periods[u % count];
+        linearJobs[count].remainingTime = periods[u % count];
+        linearJobs[count].isPending     = 0U;
+        linearJobs[count].callback      = Benchmark_Callback;
+        linearJobCount                  = count + 1U;
+        (void)Linear_Process(0U);
+        const uint64_t insertedTime = Benchmark_GetTime();
+        linearJobCount              = count;
+        (void)Linear_Process(0U);
+        const uint64_t cancelledTime = Benchmark_GetTime();
+
+        *insertTime += insertedTime - startTime;
+        *cancelTime += cancelledTime - insertedTime;
+    }
+}
+
+/**
+ * @brief  Process the remaining time of the jobs and search for the job with
+ *         the lowest remaining time, as the original scheduler did upon each
+ *         wakeup.
+ *
+ * @param elapsedTime  The time elapsed since the previous wakeup in [s].
+ * @return  The time until the next wakeup in [s].
+ */
+uint32_t Linear_Process(const uint32_t elapsedTime)
+{
+    uint32_t indexOfNextJob = 0U;
+
+    for(uint32_t i = 0U; i < linearJobCount; ++i)
+    {
+        if(elapsedTime >= linearJobs[i].remainingTime)
+        {
+            linearJobs[i].remainingTime = linearJobs[i].period;
+            linearJobs[i].isPending     = 1U;
+        }
+        else
+        {
+            linearJobs[i].remainingTime -= elapsedTime;
+        }
+    }
+
+    for(uint32_t i = 0U; i < linearJobCount; ++i)
+    {
+        if(linearJobs[i].remainingTime <
+           linearJobs[indexOfNextJob].remainingTime)
+        {
+            indexOfNextJob = i;
+        }
+    }
+
+    return linearJobs[indexOfNextJob].remainingTime;
+}
+
+/**
+ * @brief  Execute the pending jobs of the linear scan.
+ */
+void Linear_ExecutePendingJobs(void)
+{
+    for(uint32_t i = 0U; i < linearJobCount; ++i)
+    {
+        if(linearJobs[i].isPending != 0U)
+        {
+            linearJobs[i].callback(NULL);
+            linearJobs[i].isPending = 0U;
+        }
+    }
+}
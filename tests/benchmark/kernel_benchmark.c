@@ -0,0 +1,302 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    kernel_benchmark.c
+ * @brief   This file contains the benchmark of the countdown kernel of the
+ *          packed queue backend. The countdown of the lanes with the due
+ *          bitmask, i.e. SchedulerPacked_Advance() with
+ *          SchedulerPacked_GetDueMask(), is compared against the per-job
+ *          comparison and subtraction of the remaining times of the original
+ *          scheduler.
+ *
+ * Both kernels count down the same remaining times by one second per step and
+ * build the bitmask of the due jobs. The remaining times and the bitmasks are
+ * compared after each batch of steps, thus the benchmark also fails if the
+ * kernels disagree. Built with the CMSIS headers of the target, the kernels
+ * are measured in cycles of the DWT cycle counter and the DSP instructions of
+ * the packed backend are used; the output needs a retargeted console. On the
+ * host, the kernels are measured in nanoseconds with the portable functions.
+ *
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "scheduler_queue.h"
+#include <stdio.h>
+#ifndef DWT
+#include <time.h>
+#endif
+
+#if(SCHEDULER_QUEUE != SCHEDULER_QUEUE_PACKED)
+#error "The kernel benchmark requires the packed queue backend"
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+/** The largest number of jobs of the benchmark */
+#define BENCHMARK_MAX_JOBS 256U
+
+/** The number of steps measured per batch */
+#define BENCHMARK_STEPS 1000U
+
+/** The number of batches, the fastest of which is reported */
+#define BENCHMARK_REPETITIONS 5U
+
+/** The time (Unix epoch) when the kernels are started */
+#define BENCHMARK_START_TIME 1000000U
+
+#ifdef DWT
+/** The unit of the measured time */
+#define BENCHMARK_UNIT "cycles"
+#else
+#define BENCHMARK_UNIT "ns"
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+static Scheduler_t sched;
+static Job_t jobs[BENCHMARK_MAX_JOBS];
+
+static uint32_t remainingTimes[BENCHMARK_MAX_JOBS];
+static uint32_t scalarDue[(BENCHMARK_MAX_JOBS + 31U) / 32U];
+
+/* Private function prototypes -----------------------------------------------*/
+int Benchmark_Run(const uint32_t count);
+void Benchmark_Init(const uint32_t count);
+uint32_t Benchmark_GetTime(void);
+uint32_t Benchmark_RunPacked(void);
+uint32_t Benchmark_RunScalar(const uint32_t count);
+int Benchmark_Compare(const uint32_t count);
+void Scalar_Advance(const uint32_t count, const uint32_t elapsedTime);
+
+/* The kernel of the packed queue backend, defined in scheduler_packed.c */
+void SchedulerPacked_Advance(Scheduler_t* const sched,
+                             const uint32_t currentTime);
+
+/**
+ * @brief  Run the benchmarks for 8, 16, 32, 64, 128 and 256 jobs. The job sets
+ *         that do not fit into the lanes of the packed queue backend are
+ *         skipped.
+ *
+ * @return  Zero if the kernels agree on the remaining times and on the due
+ *          jobs; otherwise one.
+ */
+int main(void)
+{
+    static const uint32_t counts[] = {8U, 16U, 32U, 64U, 128U, 256U};
+    int result                     = 0;
+
+#ifdef DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    printf("Packed kernel: %u lanes, %u steps per batch\n",
+           (unsigned)SCHEDULER_PACKED_LANES,
+           (unsigned)BENCHMARK_STEPS);
+    printf("%6s %16s %16s\n", "Jobs", "Packed [" BENCHMARK_UNIT "]",
+           "Scalar [" BENCHMARK_UNIT "]");
+
+    for(size_t i = 0U; i < (sizeof(counts) / sizeof(counts[0])); ++i)
+    {
+        if(counts[i] > SCHEDULER_PACKED_LANES)
+        {
+            printf("%6u %16s\n", (unsigned)counts[i], "skipped");
+        }
+        else if(Benchmark_Run(counts[i]) != 0)
+        {
+            result = 1;
+        }
+        else
+        {
+            /* The kernels agree */
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Run the benchmark for a number of jobs and print its results per
+ *         step.
+ *
+ * @param count  The number of jobs.
+ * @return  Zero if the kernels agree; otherwise one.
+ */
+int Benchmark_Run(const uint32_t count)
+{
+    int result          = 0;
+    uint32_t packedTime = UINT32_MAX;
+    uint32_t scalarTime = UINT32_MAX;
+
+    for(uint32_t r = 0U; (r < BENCHMARK_REPETITIONS) && (result == 0); ++r)
+    {
+        Benchmark_Init(count);
+
+        const uint32_t packed = Benchmark_RunPacked();
+        const uint32_t scalar = Benchmark_RunScalar(count);
+        packedTime            = (packed < packedTime) ? packed : packedTime;
+        scalarTime            = (scalar < scalarTime) ? scalar : scalarTime;
+
+        result = Benchmark_Compare(count);
+    }
+
+    if(result == 0)
+    {
+        printf("%6u %16.1f %16.1f\n",
+               (unsigned)count,
+               (double)packedTime / BENCHMARK_STEPS,
+               (double)scalarTime / BENCHMARK_STEPS);
+    }
+    else
+    {
+        printf("%6u Mismatch between the packed and the scalar kernel\n",
+               (unsigned)count);
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Insert the jobs into the packed queue and into the remaining times of
+ *         the scalar kernel.
+ *
+ * The remaining times are generated between one second and twice the steps of
+ * a batch with a fixed pseudo-random sequence, thus about half of the jobs
+ * become due during a batch.
+ *
+ * @param count  The number of jobs.
+ */
+void Benchmark_Init(const uint32_t count)
+{
+    uint32_t seed = 12345U;
+
+    sched.capacity = (uint16_t)count;
+    sched.jobs     = jobs;
+    SchedulerQueueInit(&sched, BENCHMARK_START_TIME);
+
+    for(uint32_t i = 0U; i < count; ++i)
+    {
+        seed              = (seed * 1103515245U) + 12345U;
+        remainingTimes[i] = 1U + ((seed >> 8U) % (2U * BENCHMARK_STEPS));
+
+        jobs[i].deadline = BENCHMARK_START_TIME + remainingTimes[i];
+        SchedulerQueueInsert(&sched, (uint16_t)i);
+    }
+}
+
+/**
+ * @brief  Get the time of the cycle counter on the target, or the monotonic
+ *         time of the host.
+ *
+ * @return  The time in [cycles] on the target or in [ns] on the host.
+ */
+uint32_t Benchmark_GetTime(void)
+{
+#ifdef DWT
+    return DWT->CYCCNT;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000000U) +
+                      (uint64_t)now.tv_nsec);
+#endif
+}
+
+/**
+ * @brief  Count down the lanes of the packed queue for a batch of steps.
+ *
+ * @return  The time spent in the batch.
+ */
+uint32_t Benchmark_RunPacked(void)
+{
+    const uint32_t startTime = Benchmark_GetTime();
+
+    for(uint32_t s = 1U; s <= BENCHMARK_STEPS; ++s)
+    {
+        SchedulerPacked_Advance(&sched, BENCHMARK_START_TIME + s);
+    }
+
+    return Benchmark_GetTime() - startTime;
+}
+
+/**
+ * @brief  Count down the remaining times of the scalar kernel for a batch of
+ *         steps.
+ *
+ * @param count  The number of jobs.
+ * @return  The time spent in the batch.
+ */
+uint32_t Benchmark_RunScalar(const uint32_t count)
+{
+    const uint32_t startTime = Benchmark_GetTime();
+
+    for(uint32_t s = 1U; s <= BENCHMARK_STEPS; ++s)
+    {
+        Scalar_Advance(count, 1U);
+    }
+
+    return Benchmark_GetTime() - startTime;
+}
+
+/**
+ * @brief  Compare the lanes and the due jobs of the packed queue with the
+ *         remaining times and the due jobs of the scalar kernel.
+ *
+ * @param count  The number of jobs.
+ * @return  Zero if the kernels agree; otherwise one.
+ */
+int Benchmark_Compare(const uint32_t count)
+{
+    int result = 0;
+
+    for(uint32_t i = 0U; i < count; ++i)
+    {
+        const uint32_t lane =
+            (sched.queue.lanes[i / 2U] >> ((i % 2U) * 16U)) & 0xFFFFU;
+        const uint32_t mask = 1UL << (i % 32U);
+
+        if((lane != remainingTimes[i]) ||
+           ((sched.queue.due[i / 32U] & mask) != (scalarDue[i / 32U] & mask)))
+        {
+            result = 1;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief  Count down the remaining times of the jobs one by one and build the
+ *         bitmask of the due jobs, as the original scheduler did upon each
+ *         wakeup.
+ *
+ * @param count        The number of jobs.
+ * @param elapsedTime  The time elapsed since the previous step in [s].
+ */
+void Scalar_Advance(const uint32_t count, const uint32_t elapsedTime)
+{
+    for(uint32_t i = 0U; i < ((count + 31U) / 32U); ++i)
+    {
+        scalarDue[i] = 0U;
+    }
+
+    for(uint32_t i = 0U; i < count; ++i)
+    {
+        if(elapsedTime >= remainingTimes[i])
+        {
+            remainingTimes[i] = 0U;
+            scalarDue[i / 32U] |= 1UL << (i % 32U);
+        }
+        else
+        {
+            remainingTimes[i] -= elapsedTime;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ *******************************************************************************
+ * STM32 RTC Scheduler
+ *******************************************************************************
+ * @author  Akos Pasztor
+ * @file    stm32l4xx_hal.h
+ * @brief   This file replaces the HAL header for the host build of the
+ *          benchmark. It provides the types and the CMSIS intrinsics that the
+ *          scheduler core uses, implemented in portable C.
+ * @see     Please refer to README for detailed information.
+ *******************************************************************************
+ * @copyright (c) 2021 Akos Pasztor.                    https://akospasztor.com
+ *******************************************************************************
+ */
+
+#ifndef STM32L4XX_HAL_H
+#define STM32L4XX_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Defines -------------------------------------------------------------------*/
+/** Parameter checks are disabled, as in a release build of the firmware */
+#define assert_param(expr) ((void)0U)
+
+#define UNUSED(x) ((void)(x))
+
+#define RTC_WEEKDAY_MONDAY    ((uint8_t)0x01U)
+#define RTC_WEEKDAY_TUESDAY   ((uint8_t)0x02U)
+#define RTC_WEEKDAY_WEDNESDAY ((uint8_t)0x03U)
+#define RTC_WEEKDAY_THURSDAY  ((uint8_t)0x04U)
+#define RTC_WEEKDAY_FRIDAY    ((uint8_t)0x05U)
+#define RTC_WEEKDAY_SATURDAY  ((uint8_t)0x06U)
+#define RTC_WEEKDAY_SUNDAY    ((uint8_t)0x07U)
+
+/* Structures ----------------------------------------------------------------*/
+typedef struct
+{
+    uint8_t WeekDay;
+    uint8_t Month;
+    uint8_t Date;
+    uint8_t Year;
+} RTC_DateTypeDef;
+
+typedef struct
+{
+    uint8_t Hours;
+    uint8_t Minutes;
+    uint8_t Seconds;
+    uint8_t TimeFormat;
+    uint32_t SubSeconds;
+    uint32_t SecondFraction;
+    uint32_t DayLightSaving;
+    uint32_t StoreOperation;
+} RTC_TimeTypeDef;
+
+/* Functions -----------------------------------------------------------------*/
+uint32_t HAL_GetTick(void);
+
+/* The benchmark is single-threaded, thus the exclusive accesses always succeed
+ * and the barriers are not needed */
+static inline uint32_t __LDREXW(volatile uint32_t* address)
+{
+    return *address;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t* address)
+{
+    *address = value;
+    return 0U;
+}
+
+static inline uint8_t __LDREXB(volatile uint8_t* address)
+{
+    return *address;
+}
+
+static inline uint32_t __STREXB(uint8_t value, volatile uint8_t* address)
+{
+    *address = value;
+    return 0U;
+}
+
+static inline void __CLREX(void)
+{
+}
+
+static inline void __DMB(void)
+{
+}
+
+static inline uint32_t __CLZ(uint32_t value)
+{
+    return (value != 0U) ? (uint32_t)__builtin_clz(value) : 32U;
+}
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+    value = ((value >> 1U) & 0x55555555U) | ((value & 0x55555555U) << 1U);
+    value = ((value >> 2U) & 0x33333333U) | ((value & 0x33333333U) << 2U);
+    value = ((value >> 4U) & 0x0F0F0F0FU) | ((value & 0x0F0F0F0FU) << 4U);
+    value = ((value >> 8U) & 0x00FF00FFU) | ((value & 0x00FF00FFU) << 8U);
+
+    return (value >> 16U) | (value << 16U);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32L4XX_HAL_H */
@@ -8,8 +8,26 @@ def pytest_addoption(parser):
         "--executable", action="store", default="clang-format",
         help="Path of clang-format if it's not added to PATH"
     )
+    parser.addoption(
+        "--cc", action="store", default="gcc",
+        help="Host C compiler of the benchmark"
+    )
+    parser.addoption(
+        "--target-cc", action="store", default="arm-none-eabi-gcc",
+        help="Cross compiler of the target build of the benchmark kernels"
+    )
 
 
 @pytest.fixture
 def clang_format_executable(request):
     return request.config.getoption("--executable")
+
+
+@pytest.fixture
+def host_compiler(request):
+    return request.config.getoption("--cc")
+
+
+@pytest.fixture
+def target_compiler(request):
+    return request.config.getoption("--target-cc")
@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+import os
+import shutil
+import subprocess
+import pytest
+
+# Project path, this module resides one folder down relative to it
+PROJECT_PATH = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Sources of the host build of the benchmark, relative to project path
+BENCHMARK_SOURCES = ["tests/benchmark/benchmark.c",
+                     "source/atomic.c",
+                     "source/scheduler.c",
+                     "source/scheduler_heap.c",
+                     "source/scheduler_packed.c",
+                     "source/scheduler_wheel.c"]
+
+# Sources of the benchmark of the packed queue kernel, relative to project path
+KERNEL_BENCHMARK_SOURCES = ["tests/benchmark/kernel_benchmark.c",
+                            "source/scheduler_packed.c"]
+
+# Include locations of the target build, relative to project path
+TARGET_INCLUDES = ["include",
+                   "drivers/CMSIS/Include",
+                   "drivers/CMSIS/Device/ST/STM32L4xx/Include",
+                   "drivers/STM32L4xx_HAL_Driver/Inc"]
+
+# Microcontroller flags and defines of the target build
+TARGET_FLAGS = ["-mcpu=cortex-m4", "-mthumb", "-mfpu=fpv4-sp-d16",
+                "-mfloat-abi=hard", "-DSTM32L496xx", "-DUSE_HAL_DRIVER"]
+
+
+def build_benchmark(compiler, output, defines=[], sources=BENCHMARK_SOURCES):
+    compiler_args = [compiler, "-O2", "-std=c99", "-Wall",
+                     "-D_POSIX_C_SOURCE=199309L"]
+    compiler_args += ["-D{}".format(d) for d in defines]
+    compiler_args.append("-I{}".format(
+        os.path.join(PROJECT_PATH, "tests", "benchmark")))
+    compiler_args.append("-I{}".format(os.path.join(PROJECT_PATH, "include")))
+    compiler_args += [os.path.join(PROJECT_PATH, os.path.normpath(s))
+                      for s in sources]
+    compiler_args += ["-o", output]
+    subprocess.check_call(compiler_args)
+
+
+def run_benchmark(executable):
+    result = subprocess.run([executable], stdout=subprocess.PIPE,
+                            universal_newlines=True)
+    print(result.stdout)
+    return result.returncode
+
+
+@pytest.mark.parametrize("backend, defines", [
+    ("heap", ["SCHEDULER_QUEUE=0U"]),
+    ("wheel", ["SCHEDULER_QUEUE=1U"]),
+    ("packed", ["SCHEDULER_QUEUE=2U", "SCHEDULER_PACKED_LANES=288U"]),
+])
+def test_benchmark(host_compiler, tmp_path, backend, defines):
+    if shutil.which(host_compiler) is None:
+        pytest.skip("Host compiler {} is not available".format(host_compiler))
+
+    executable = str(tmp_path / "benchmark_{}".format(backend))
+    build_benchmark(host_compiler, executable, defines)
+    assert run_benchmark(executable) == 0
+
+
+def test_kernel_benchmark(host_compiler, tmp_path):
+    if shutil.which(host_compiler) is None:
+        pytest.skip("Host compiler {} is not available".format(host_compiler))
+
+    executable = str(tmp_path / "kernel_benchmark")
+    build_benchmark(host_compiler, executable,
+                    ["SCHEDULER_QUEUE=2U", "SCHEDULER_PACKED_LANES=288U"],
+                    KERNEL_BENCHMARK_SOURCES)
+    assert run_benchmark(executable) == 0
+
+
+def test_kernel_target_build(target_compiler, tmp_path):
+    # The host build only compiles the portable functions of the packed
+    # backend, thus its DSP instructions are compiled for the target here
+    if shutil.which(target_compiler) is None:
+        pytest.skip("Target compiler {} is not available".format(
+            target_compiler))
+
+    for source in KERNEL_BENCHMARK_SOURCES:
+        compiler_args = [target_compiler, "-O2", "-std=c99", "-Wall", "-c",
+                         "-DSCHEDULER_QUEUE=2U"] + TARGET_FLAGS
+        compiler_args += ["-I{}".format(
+            os.path.join(PROJECT_PATH, os.path.normpath(i)))
+            for i in TARGET_INCLUDES]
+        compiler_args.append(os.path.join(PROJECT_PATH,
+                                          os.path.normpath(source)))
+        compiler_args += ["-o", str(tmp_path / "{}.o".format(
+            os.path.splitext(os.path.basename(source))[0]))]
+        subprocess.check_call(compiler_args)
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+import pytest
+from python.generate_schedule import compute_entries, compute_hyperperiod
+
+
+def make_jobs(*jobs):
+    return [{"name": "job{}".format(i), "period": period, "delay": delay}
+            for i, (period, delay) in enumerate(jobs)]
+
+
+@pytest.mark.parametrize("jobs", [
+    make_jobs((5, 5)),
+    make_jobs((6, 6), (10, 5), (15, 15)),
+    make_jobs((4, 1), (9, 9), (7, 3)),
+    make_jobs((60, 60), (61, 61), (119, 119)),
+])
+def test_entries_wrap_at_hyperperiod(jobs):
+    hyperperiod = compute_hyperperiod(jobs)
+    entries = compute_entries(jobs, hyperperiod)
+    offsets = [offset for offset, mask in entries]
+
+    # The offsets are distinct, sorted and within (0, hyperperiod]
+    assert offsets == sorted(set(offsets))
+    assert all(0 < offset <= hyperperiod for offset in offsets)
+
+    # Repeating the entries after the hyperperiod gives the wakeups of each
+    # job over several hyperperiods
+    for bit, job in enumerate(jobs):
+        expected = list(range(job["delay"], 3 * hyperperiod + 1,
+                              job["period"]))
+        actual = [cycle * hyperperiod + offset
+                  for cycle in range(3)
+                  for offset, mask in entries if mask & (1 << bit)]
+        assert actual == expected
+
+
+@pytest.mark.parametrize("jobs", [
+    make_jobs((1, 1), (65537, 65537)),
+    make_jobs((5, 5), (7, 7), (210000, 210000)),
+])
+def test_too_many_entries(jobs):
+    with pytest.raises(ValueError):
+        compute_entries(jobs, compute_hyperperiod(jobs))